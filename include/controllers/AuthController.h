@@ -2,14 +2,14 @@
 #define AUTHCONTROLLER_H
 
 #include "controllers/UserController.h"
-#include "services/jwt/Auth0JwtUtils.h"
+#include "services/jwt/Auth0KeyStore.h"
 #include <cpprest/http_msg.h>
 #include <cpprest/json.h>
 #include <string>
 #include <sodium.h>
-#include "env/EnvLoader.h"
+#include "env/Config.h"
 #include "services/jwt/JwtService.h"
-#include <future> // Para usar std::async
+#include "services/PasswordHasher.h"
 #include <cpprest/http_client.h>
 #include <cpprest/uri.h> 
 
@@ -19,10 +19,12 @@ class AuthController
 private:
     UserController userController;
 
+    void rehashPassword(int user_id, const std::string &password);
+
 public:
     AuthController();
-    web::http::http_response signup(const web::http::http_request &request);
-    web::http::http_response login(const web::http::http_request &request);
+    pplx::task<web::http::http_response> signup(const web::http::http_request &request);
+    pplx::task<web::http::http_response> login(const web::http::http_request &request);
     web::http::http_response googleLogin(const web::http::http_request &request);
 };
 
@@ -8,5 +8,6 @@ class AuthUtils
 {
 public:
     static std::optional<DecodedUser> getUserFromRequest(const web::http::http_request& request);
+    static std::optional<std::string> getTokenFromRequest(const web::http::http_request& request);
 };
 
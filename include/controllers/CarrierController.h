@@ -8,6 +8,7 @@
 #include "db/DatabaseConnection.h"
 #include "entities/Carrier.h"
 #include "model/CarrierModel.h"
+#include "services/ReferenceDataCache.h"
 #include "AuthUtils.h"
 #include "services/jwt/JwtService.h"
 #include "utils/Errors.h"
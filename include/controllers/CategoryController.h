@@ -4,16 +4,13 @@
 #include <cpprest/json.h>
 #include <optional>
 #include <vector>
-#include "model/CategoryModel.h" // Incluimos el modelo
+#include "services/ReferenceDataCache.h"
 
 class CategoryController
 {
-private:
-    CategoryModel model;
-
 public:
     CategoryController() {};
-    web::http::http_response getAllCategories();
+    web::http::http_response getAllCategories(const web::http::http_request &request);
 };
 
 #endif
\ No newline at end of file
@@ -22,8 +22,8 @@ public:
     OrderController();
     web::http::http_response createOrder(const web::http::http_request &request, const int user_id);
     web::http::http_response getOrdersByUserId(const web::http::http_request &request, const int user_id);
-    web::http::http_response getOrderById(const web::http::http_request &request, const int user_id);
-    web::http::http_response updateTotalbyOrderId(const web::http::http_request &request, const int user_id);
+    web::http::http_response getOrderById(const web::http::http_request &request, const int user_id, int order_id);
+    web::http::http_response updateTotalbyOrderId(const web::http::http_request &request, const int user_id, int order_id, int carrier_id);
 };
 
 #endif
\ No newline at end of file
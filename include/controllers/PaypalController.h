@@ -5,6 +5,8 @@
 #include "AuthUtils.h"
 #include "model/OrderModel.h"
 #include "model/PaymentAttemptModel.h"
+#include "utils/Deadline.h"
+#include "env/Config.h"
 
 
 
@@ -12,8 +14,8 @@ class PaypalController
 {
 public:
     PaypalController();
-    web::http::http_response createPayment(const web::http::http_request &request, const int user_id);
-    web::http::http_response capturePayment(const web::http::http_request &request, const int user_id);
+    pplx::task<web::http::http_response> createPayment(const web::http::http_request &request, const int user_id, int order_id);
+    pplx::task<web::http::http_response> capturePayment(const web::http::http_request &request, const int user_id, utility::string_t order_id_paypal, int order_id);
 };
 
 #endif // PAYPALCONTROLLER_H
\ No newline at end of file
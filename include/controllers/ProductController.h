@@ -7,13 +7,10 @@
 #include <vector>
 #include <iostream>
 #include <string>
-#include "model/ProductModel.h" // Incluimos el modelo
+#include "services/ProductCatalogCache.h"
 
 class ProductController
 {
-private:
-    ProductModel model;
-
 public:
     ProductController();
     web::http::http_response getAllProducts();
@@ -23,6 +23,7 @@ public:
 
     std::optional<User> getUserById(int user_id);
     std::optional<User> getUserByEmail(const std::string &email);
+    bool updatePassword(int user_id, const std::string &password);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include "db/DatabaseConnection.h"
+
+class ConnectionPool;
+
+// Préstamo RAII de una conexión del pool. Se devuelve al destruirse.
+// Los préstamos anidados en el mismo hilo (un modelo que llama a otro)
+// comparten la conexión, y con ella la transacción abierta.
+// No debe pasarse a otro hilo.
+class PooledConnection
+{
+public:
+    PooledConnection() = default;
+    ~PooledConnection();
+
+    PooledConnection(PooledConnection &&other) noexcept;
+    PooledConnection &operator=(PooledConnection &&other) noexcept;
+    PooledConnection(const PooledConnection &) = delete;
+    PooledConnection &operator=(const PooledConnection &) = delete;
+
+    // nullptr si no se pudo obtener conexión (timeout o fallo al conectar)
+    MYSQL *getConnection() const { return connection_ ? connection_->getConnection() : nullptr; }
+    explicit operator bool() const { return connection_ != nullptr; }
+
+    CachedStatement prepare(std::string_view sql) { return connection_->prepare(sql); }
+    bool inTransaction() const { return connection_ && connection_->inTransaction(); }
+
+private:
+    friend class ConnectionPool;
+    PooledConnection(ConnectionPool *pool, std::unique_ptr<DatabaseConnection> owned);
+    PooledConnection(ConnectionPool *pool, DatabaseConnection *shared);
+
+    void release();
+
+    ConnectionPool *pool_ = nullptr;
+    std::unique_ptr<DatabaseConnection> owned_;
+    DatabaseConnection *connection_ = nullptr;
+};
+
+class ConnectionPool
+{
+public:
+    struct Settings
+    {
+        size_t minSize = 2;
+        size_t maxSize = 10;
+        std::chrono::milliseconds acquireTimeout{5000};
+        // Solo se hace ping a conexiones que llevan más de esto sin usarse
+        std::chrono::milliseconds validateAfterIdle{30000};
+    };
+
+    struct Stats
+    {
+        size_t total = 0;
+        size_t leased = 0;
+        size_t idle = 0;
+        size_t waiting = 0;
+        uint64_t acquired = 0;
+        uint64_t timeouts = 0;
+        uint64_t discarded = 0;
+        std::chrono::microseconds totalWait{0};
+        std::chrono::microseconds maxWait{0};
+        uint64_t statementHits = 0;
+        uint64_t statementMisses = 0;
+    };
+
+    // Configurado desde .env (DB_HOST..., DB_POOL_MIN, DB_POOL_MAX,
+    // DB_POOL_ACQUIRE_TIMEOUT_MS, DB_POOL_VALIDATE_IDLE_MS)
+    static ConnectionPool &getInstance();
+
+    PooledConnection acquire();
+    Stats stats() const;
+
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+private:
+    friend class PooledConnection;
+
+    ConnectionPool(DatabaseSettings database, Settings settings);
+    ~ConnectionPool() = default;
+
+    std::unique_ptr<DatabaseConnection> takeIdle(std::unique_lock<std::mutex> &lock);
+    std::unique_ptr<DatabaseConnection> openConnection();
+    void release(std::unique_ptr<DatabaseConnection> connection);
+
+    const DatabaseSettings database_;
+    const Settings settings_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::unique_ptr<DatabaseConnection>> idle_;
+    Stats stats_;
+};
+
+#endif
@@ -3,30 +3,55 @@
 
 #pragma once
 #include <mysql/mysql.h>
+#include <chrono>
 #include <string>
+#include "db/StatementCache.h"
 
+// Parámetros de conexión compartidos por todas las conexiones del pool
+struct DatabaseSettings
+{
+    std::string host;
+    std::string user;
+    std::string password;
+    std::string dbname;
+    unsigned int port = 3306;
+};
+
+// Una conexión física a MySQL. Las reparte ConnectionPool; no se usa directamente.
 class DatabaseConnection
 {
 public:
-    static DatabaseConnection &getInstance();
+    explicit DatabaseConnection(const DatabaseSettings &settings);
+    ~DatabaseConnection();
+
+    DatabaseConnection(const DatabaseConnection &) = delete;
+    DatabaseConnection &operator=(const DatabaseConnection &) = delete;
 
-    MYSQL *getConnection();
+    bool connect();
     void close();
 
-private:
-    DatabaseConnection();
-    ~DatabaseConnection();
+    // Devuelve el handle sin hacer ping; la validación la decide el pool
+    MYSQL *getConnection() const { return connection; }
 
-    bool connect();
+    // Sentencia preparada reutilizable; se invalida al reconectar
+    CachedStatement prepare(std::string_view sql) { return statements_.prepare(connection, sql); }
+    StatementCache::Stats statementStats() const { return statements_.stats(); }
 
-    MYSQL *connection;
+    bool isOpen() const { return connection != nullptr; }
+    bool ping();
 
-    // Parámetros de conexión
-    std::string host;
-    std::string user;
-    std::string password;
-    std::string dbname;
-    unsigned int port;
+    // true si el último error indica que el servidor cerró la conexión
+    bool isBroken() const;
+    bool inTransaction() const;
+
+    std::chrono::steady_clock::time_point lastUsed() const { return lastUsed_; }
+    void touch() { lastUsed_ = std::chrono::steady_clock::now(); }
+
+private:
+    MYSQL *connection;
+    const DatabaseSettings &settings_;
+    StatementCache statements_;
+    std::chrono::steady_clock::time_point lastUsed_;
 };
 
-#endif
\ No newline at end of file
+#endif
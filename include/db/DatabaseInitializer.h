@@ -1,7 +1,7 @@
 #ifndef DATABASEINITIALIZER_H
 #define DATABASEINITIALIZER_H
 
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 
 class DatabaseInitializer
 {
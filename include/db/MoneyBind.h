@@ -0,0 +1,50 @@
+#ifndef MONEYBIND_H
+#define MONEYBIND_H
+
+#include <mysql/mysql.h>
+#include <optional>
+#include <string_view>
+#include "utils/Money.h"
+
+// Enlaza Money con columnas DECIMAL(10,2) como MYSQL_TYPE_NEWDECIMAL: el
+// importe viaja como texto exacto en ambos sentidos, sin pasar por double.
+// El buffer vive en este objeto, que debe sobrevivir al execute/fetch.
+struct MoneyBind
+{
+    Money::Formatted text;
+    unsigned long length = 0;
+    bool isNull = false;
+
+    // Parámetro de entrada con el valor ya formateado
+    void bindParam(MYSQL_BIND &bind, const Money &value)
+    {
+        text = value.format();
+        length = static_cast<unsigned long>(text.size);
+        bind.buffer_type = MYSQL_TYPE_NEWDECIMAL;
+        bind.buffer = text.data.data();
+        bind.buffer_length = length;
+        bind.length = &length;
+    }
+
+    // Columna de resultado; leer con value() tras cada fetch
+    void bindResult(MYSQL_BIND &bind)
+    {
+        bind.buffer_type = MYSQL_TYPE_NEWDECIMAL;
+        bind.buffer = text.data.data();
+        bind.buffer_length = text.data.size();
+        bind.length = &length;
+        bind.is_null = &isNull;
+    }
+
+    // nullopt si la columna es NULL, no cabe en el buffer o no es un
+    // DECIMAL con dos decimales como mucho: el llamador debe fallar la
+    // consulta en vez de inventarse un importe
+    std::optional<Money> value() const
+    {
+        if (isNull || length > text.data.size())
+            return std::nullopt;
+        return Money::parse(std::string_view(text.data.data(), length));
+    }
+};
+
+#endif // MONEYBIND_H
@@ -0,0 +1,93 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <mysql/mysql.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class StatementCache;
+
+struct StatementEntry
+{
+    MYSQL_STMT *stmt = nullptr;
+    bool inUse = false;
+};
+
+// Sentencia preparada prestada por la caché. Al destruirse libera el
+// resultado pendiente y la sentencia vuelve a la caché sin cerrarse.
+class CachedStatement
+{
+public:
+    CachedStatement() = default;
+    ~CachedStatement();
+
+    CachedStatement(CachedStatement &&other) noexcept;
+    CachedStatement &operator=(CachedStatement &&other) noexcept;
+    CachedStatement(const CachedStatement &) = delete;
+    CachedStatement &operator=(const CachedStatement &) = delete;
+
+    // nullptr si la sentencia no se pudo preparar; ver error()
+    MYSQL_STMT *get() const { return stmt_; }
+    explicit operator bool() const { return stmt_ != nullptr; }
+    const char *error() const { return error_.c_str(); }
+
+private:
+    friend class StatementCache;
+
+    CachedStatement(MYSQL_STMT *stmt, StatementEntry *entry) : stmt_(stmt), entry_(entry) {}
+    explicit CachedStatement(std::string error) : error_(std::move(error)) {}
+
+    void release();
+
+    MYSQL_STMT *stmt_ = nullptr;
+    StatementEntry *entry_ = nullptr; // nullptr: sentencia fuera de caché, se cierra al liberar
+    std::string error_;
+};
+
+// Caché de sentencias preparadas por conexión, indexada por el texto SQL.
+// No es thread-safe: la conexión que la posee solo la usa un hilo a la vez.
+class StatementCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t size = 0;
+    };
+
+    explicit StatementCache(size_t capacity = 128);
+    ~StatementCache();
+
+    StatementCache(const StatementCache &) = delete;
+    StatementCache &operator=(const StatementCache &) = delete;
+
+    CachedStatement prepare(MYSQL *conn, std::string_view sql);
+
+    // Cierra todas las sentencias; se llama antes de reconectar o cerrar la conexión
+    void clear();
+
+    Stats stats() const;
+    // Contadores acumulados de todas las conexiones del proceso
+    static Stats totals();
+
+private:
+    struct Hash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view sql) const { return std::hash<std::string_view>{}(sql); }
+    };
+
+    std::unordered_map<std::string, StatementEntry, Hash, std::equal_to<>> entries_;
+    size_t capacity_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+
+    static std::atomic<uint64_t> totalHits_;
+    static std::atomic<uint64_t> totalMisses_;
+};
+
+#endif
@@ -2,12 +2,13 @@
 #define CARRIER_H
 
 #include <string>
+#include "utils/Money.h"
 
 struct Carrier
 {
     int id;
     std::string name;
-    double price;
+    Money price;
 };
 
 #endif
\ No newline at end of file
@@ -14,4 +14,5 @@ struct DecodedUser {
     std::string family_name;    // apellido
     std::string picture;        // URL de la foto de perfil
     std::string locale;         // idioma del perfil (ej. "es")
+    long long exp = 0;          // expiración del token (segundos desde epoch)
 };
\ No newline at end of file
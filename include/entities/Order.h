@@ -2,6 +2,7 @@
 #define ORDER_H
 
 #include <string>
+#include "utils/Money.h"
 
 struct Order
 {
@@ -11,7 +12,7 @@ struct Order
     int billing_address_id;
     std::string order_date;
     std::string status;
-    double total;
+    Money total;
     std::string shipment_date;
     std::string delivery_date;
     int carrier_id;
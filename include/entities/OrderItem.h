@@ -2,6 +2,7 @@
 #define ORDERITEM_H
 
 #include <string>
+#include "utils/Money.h"
 
 struct OrderItem
 {
@@ -9,7 +10,7 @@ struct OrderItem
     int order_id;
     int product_id;
     int quantity;
-    double price;
+    Money price;
 };
 
 #endif
@@ -2,6 +2,7 @@
 #define PAYMENTATTEMP_H
 
 #include <string>
+#include "utils/Money.h"
 
 struct PaymentAttempt
 {
@@ -9,7 +10,7 @@ struct PaymentAttempt
     int user_id;
     int order_id;
     std::string cart_hash;
-    double total;
+    Money total;
     std::string idempotency_key;
     std::string paypal_order_id;
     std::string status;
@@ -0,0 +1,75 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// Configuración tipada e inmutable. Se carga una vez desde .env; las
+// variables de entorno del proceso tienen prioridad sobre el fichero.
+// Config::get() es una lectura atómica del snapshot actual (sin locks);
+// reload() publica un snapshot nuevo y SIGHUP lo dispara en caliente.
+// Lo que se lee en cada petición (JWT_SECRET, PayPal) ve el cambio; el pool
+// y las cachés se construyen al arrancar y mantienen sus valores iniciales.
+struct Config
+{
+    // Base de datos
+    std::string dbHost = "localhost";
+    std::string dbUser = "root";
+    std::string dbPassword;
+    std::string dbName = "tienda_del_alma";
+    unsigned int dbPort = 3306;
+    size_t dbPoolMin = 2;
+    size_t dbPoolMax = 10;
+    std::chrono::milliseconds dbPoolAcquireTimeout{5000};
+    std::chrono::milliseconds dbPoolValidateIdle{30000};
+
+    // Servidor
+    std::string serverAddress = "http://localhost:8080";
+
+    // Cachés
+    std::chrono::seconds productsCacheTtl{300};
+    std::chrono::seconds referenceCacheTtl{300};
+    size_t authTokenCacheSize = 10000;
+    std::chrono::seconds authTokenCacheMaxTtl{300};
+
+    // Autenticación
+    std::string jwtSecret;
+    std::string googleClientId;
+    std::string auth0Issuer;
+    std::string auth0PublicKeyPath = "config/auth0_public.pem";
+    std::string auth0JwksPath;
+    std::chrono::seconds auth0KeysReload{60};
+
+    // Hashing de contraseñas (Argon2)
+    size_t passwordHashWorkers = 2;
+    size_t passwordHashQueueMax = 32;
+    size_t passwordHashMemoryBudgetMb = 512;
+    std::chrono::seconds passwordHashRetryAfter{2};
+    std::string passwordHashProfile = "moderate";
+    unsigned long long passwordHashOpsLimit = 3;
+    size_t passwordHashMemLimitMb = 64;
+    std::chrono::milliseconds passwordHashTargetVerify{250};
+
+    // PayPal
+    std::string paypalClientId;
+    std::string paypalClientSecret;
+    std::string paypalApiBase = "https://api-m.sandbox.paypal.com";
+    std::chrono::seconds paypalTokenRefreshMargin{60};
+    std::chrono::seconds paypalHttpTimeout{30};
+    std::chrono::milliseconds paypalRequestDeadline{20000};
+
+    // Snapshot vigente; la referencia sigue siendo válida tras un reload()
+    static const Config &get();
+
+    // Vuelve a leer el fichero y el entorno y publica el nuevo snapshot
+    static void reload(const std::string &filename = ".env");
+
+    // Bloquea SIGHUP y lanza un hilo que llama a reload() al recibirla.
+    // Debe llamarse al arrancar, antes de crear otros hilos.
+    static void watchReloadSignal();
+
+    static Config load(const std::string &filename = ".env");
+};
+
+#endif // CONFIG_H
@@ -2,17 +2,44 @@
 #define AUTH_MIDDLEWARE_H
 
 #include <cpprest/http_msg.h>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include "entities/DecodedUser.h"
 #include "controllers/UserController.h"
 #include "controllers/AuthUtils.h"
 
+// Origen de un token según su cabecera (alg) y su emisor (iss)
+enum class TokenType
+{
+    Local,   // HS256 emitido por tienda_del_alma (cookie de login)
+    Auth0,   // RS256 de Auth0 / Google
+    Unknown
+};
 
 class AuthMiddleware {
 public:
-    static std::optional<DecodedUser> authenticateGoogleRequest(const web::http::http_request& request);
+    struct VerifierStats
+    {
+        uint64_t attempts = 0;
+        uint64_t failures = 0;
+        uint64_t totalMicros = 0; // latencia acumulada de la verificación
+    };
+
+    struct Stats
+    {
+        VerifierStats local;
+        VerifierStats auth0;
+        uint64_t cacheHits = 0;
+        uint64_t rejected = 0; // tokens mal formados o de tipo desconocido
+    };
+
     static std::optional<DecodedUser> authenticateRequest(const web::http::http_request& request);
+    static Stats stats();
+
+private:
+    static std::optional<std::string> getBearerToken(const web::http::http_request& request);
+    static std::optional<DecodedUser> authenticateToken(const std::string& token);
 };
 
 #endif // AUTH_MIDDLEWARE_H
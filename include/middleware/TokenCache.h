@@ -0,0 +1,87 @@
+#ifndef TOKEN_CACHE_H
+#define TOKEN_CACHE_H
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "entities/DecodedUser.h"
+
+// Caché LRU de tokens ya verificados, indexada por el SHA-256 del token.
+// Repartida en shards con su propio mutex para que las peticiones
+// concurrentes no compitan por un único lock.
+class TokenCache
+{
+public:
+    using Digest = std::array<unsigned char, 32>;
+
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t size = 0;
+    };
+
+    // Configurado desde .env (AUTH_TOKEN_CACHE_SIZE, AUTH_TOKEN_CACHE_MAX_TTL_SECONDS)
+    static TokenCache &getInstance();
+
+    TokenCache(size_t capacity, std::chrono::seconds maxTtl);
+
+    // Usuario cacheado si el token sigue vigente
+    std::optional<DecodedUser> get(const std::string &token);
+
+    // Guarda el usuario hasta user.exp, como mucho maxTtl
+    void put(const std::string &token, const DecodedUser &user);
+
+    void erase(const std::string &token);
+    void clear();
+    Stats stats() const;
+
+    TokenCache(const TokenCache &) = delete;
+    TokenCache &operator=(const TokenCache &) = delete;
+
+private:
+    static constexpr size_t kShards = 16;
+
+    struct DigestHash
+    {
+        size_t operator()(const Digest &digest) const
+        {
+            size_t value;
+            std::memcpy(&value, digest.data(), sizeof(value));
+            return value;
+        }
+    };
+
+    struct Entry
+    {
+        Digest digest;
+        DecodedUser user;
+        std::chrono::system_clock::time_point expiresAt;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::list<Entry> lru; // el más reciente al principio
+        std::unordered_map<Digest, std::list<Entry>::iterator, DigestHash> index;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    static Digest digest(const std::string &token);
+    Shard &shardFor(const Digest &digest) { return shards_[digest[31] % kShards]; }
+
+    const size_t shardCapacity_;
+    const std::chrono::seconds maxTtl_;
+    std::array<Shard, kShards> shards_;
+};
+
+#endif
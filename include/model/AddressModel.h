@@ -5,7 +5,7 @@
 #include <vector>
 #include <optional>
 #include "entities/Address.h"
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include "db/DatabaseInitializer.h"
 #include "utils/Errors.h"
 
@@ -1,6 +1,6 @@
 #ifndef CARRIERMODEL_H
 #define CARRIERMODEL_H
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include "entities/Carrier.h"
 #include <optional>
 #include <vector>
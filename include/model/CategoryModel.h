@@ -1,6 +1,6 @@
 #ifndef CATEGORYMODEL_H
 #define CATEGORYMODEL_H
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include "entities/Category.h"
 #include <optional>
 #include <vector>
@@ -3,7 +3,7 @@
 
 #include <string>
 #include <iostream>
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include "entities/OrderItem.h"
 #include <optional>
 #include <vector>
@@ -19,15 +19,27 @@ private:
     int order_id;
     int product_id;
     int quantity;
-    double price;
+    Money price;
 
 public:
     OrderItemModel() {};
-    std::optional<int> createOrderItem(const std::vector<OrderItem> &products, int order_id);
-    std::optional<int> updateOrderItems(const std::vector<OrderItem> &products, int order_id);
     std::optional<int> syncOrderItems(const std::vector<OrderItem> &newItems, int order_id);
-    double calculateOrderTotal(const std::vector<OrderItem> &products);
+    Money calculateOrderTotal(const std::vector<OrderItem> &products);
     std::pair<std::optional<std::vector<OrderItem>>, Errors> getOrderItemsByOrderId(int &order_id);
+
+private:
+    // Filas por sentencia: 4 parámetros por fila, muy por debajo del límite
+    // de 65535 placeholders y de max_allowed_packet. Potencia de dos para que
+    // el relleno de insertOrderItems no cree formas nuevas.
+    static constexpr size_t kInsertBatchRows = 256;
+
+    // Upsert multi-fila en lotes: las líneas existentes (clave única
+    // order_id + product_id) actualizan cantidad y precio.
+    // No abre ni cierra transacciones.
+    bool insertOrderItems(PooledConnection &db, const std::vector<OrderItem> &products, int order_id);
+
+    // Borra las líneas del pedido cuyo producto no está en products
+    bool deleteMissingItems(PooledConnection &db, const std::vector<OrderItem> &products, int order_id);
 };
 
 #endif
\ No newline at end of file
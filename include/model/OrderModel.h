@@ -10,7 +10,7 @@
 #include "entities/Order.h"
 #include "entities/OrderItem.h"
 #include "model/OrderItemModel.h"
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include "utils/Errors.h"
 
 class OrderModel
@@ -19,38 +19,18 @@ class OrderModel
 public:
     OrderModel();
 
-    std::optional<int> createOrder(
-        const int user_id,
-        const int &shipping_address_id,
-        const int &billing_address_id,
-        const std::vector<OrderItem> &products,
-        const std::string &shipment_date,
-        const std::string &delivery_date,
-        const int &carrier_id,
-        const std::string &tracking_url,
-        const std::string &tracking_number,
-        const std::string &payment_method,
-        const std::string &payment_status);
-
     std::optional<std::vector<Order>> getOrdersByUserId(int user_id);
 
-    std::optional<Order> getPendingOrderByUserId(int user_id);
-
-    std::optional<Order> getOrderById(int order_id, int user_id);
-
-    std::pair<std::optional<Order>, Errors> updateOrder(
-        const int user_id,
-        const int &order_id,
-        const int &shipping_address_id,
-        const int &billing_address_id,
+    // POST /order en una sola transacción: bloquea al usuario y su pedido
+    // PENDING, crea o actualiza la cabecera y sincroniza las líneas.
+    // created indica si el pedido es nuevo.
+    std::pair<std::optional<Order>, Errors> upsertPendingOrder(
+        const Order &header,
         const std::vector<OrderItem> &products,
-        const std::string &shipment_date,
-        const std::string &delivery_date,
-        const int &carrier_id,
-        const std::string &tracking_url,
-        const std::string &tracking_number,
-        const std::string &payment_method,
-        const std::string &payment_status);
+        bool &created);
+
+    // NoRowsFound si la orden no existe, NotOwner si pertenece a otro usuario
+    std::pair<std::optional<Order>, Errors> getOrderById(int order_id, int user_id);
 
     std::pair<std::optional<Order>, Errors> updateOrderPaypalId(
         const int user_id,
@@ -61,8 +41,22 @@ public:
         int order_id,
         const std::string &status);
 
-    std::pair<bool, Errors> updateOrderTotal(int order_id, double total);
-    std::pair<bool, Errors> updateCarrierId(int order_id, int carrier_id);
+    // Asigna el transportista y recalcula total = líneas + envío en el servidor.
+    // Solo pedidos PENDING. Devuelve el total resultante; NoRowsFound si el
+    // pedido no existe o es de otro usuario, InvalidState si ya no está
+    // PENDING, InvalidArgument si el transportista no existe.
+    std::pair<std::optional<Money>, Errors> selectCarrier(int order_id, int user_id, int carrier_id);
+
+private:
+    bool orderExists(PooledConnection &db, int order_id);
+
+    // Escriben la cabecera dentro de la transacción abierta del llamador
+    std::optional<int> insertOrderHeader(PooledConnection &db, const Order &order);
+    std::pair<bool, Errors> updateOrderHeader(PooledConnection &db, const Order &order);
+
+    // SELECT ... FOR UPDATE del usuario y de su pedido PENDING, si lo hay.
+    // NoRowsFound si el usuario no existe.
+    std::pair<std::optional<int>, Errors> lockPendingOrder(PooledConnection &db, int user_id);
 };
 
 #endif
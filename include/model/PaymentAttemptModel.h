@@ -1,7 +1,7 @@
 #ifndef PAYMENTATTEMPTMODEL_H
 #define PAYMENTATTEMPTMODEL_H
 
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include "entities/PaymentAttempt.h"
 #include "utils/Errors.h"
 #include <optional>
@@ -19,11 +19,12 @@ public:
         int user_id,
         int order_id,
         std::string cart_hash,
-        double total,
+        const Money &total,
         std::string idempotency_key,
         std::string paypal_order_id,
         std::string status);
-    std::pair<std::optional<std::vector<PaymentAttempt>>, Errors> getPaymentAttemptsByOrderId(int order_id);
+    // Último intento PAYER_ACTION_REQUIRED de ese carrito; NoRowsFound si no hay
+    std::pair<std::optional<PaymentAttempt>, Errors> getLatestPaymentAttempt(int order_id, const std::string &cart_hash);
     std::pair<bool, Errors> updatePaymentAttemptStatus(std::string& paypal_order_id, int order_id, int user_id, const std::string& status);
 };
 
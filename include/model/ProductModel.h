@@ -5,7 +5,7 @@
 #include <string>
 #include <vector>
 #include "entities/Product.h"
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include "db/DatabaseInitializer.h"
 
 class ProductModel
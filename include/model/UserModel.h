@@ -6,7 +6,7 @@
 #include <vector>
 #include "AddressModel.h"
 #include "entities/User.h"
-#include "db/DatabaseConnection.h"
+#include "db/ConnectionPool.h"
 #include <array>
 #include <cstring> // Para std::memset
 #include <mysql/mysql.h>
@@ -19,5 +19,6 @@ public:
     std::optional<User> findUserById(int user_id);
     std::optional<User> findUserByEmail(const std::string &email);
     std::optional<User> findUserByEmailAndProvider(const std::string &email, const std::string &auth_provider);
+    bool updatePassword(int user_id, const std::string &password);
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef ROUTETABLE_H
+#define ROUTETABLE_H
+
+#include <cpprest/http_msg.h>
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "entities/DecodedUser.h"
+
+// Vista sobre un segmento de la ruta, sin copiar el string original
+using PathSegment = std::basic_string_view<utility::char_t>;
+
+// Parámetros capturados al resolver una ruta (/order/{id}/carrier/{id})
+class RouteParams
+{
+public:
+    static constexpr size_t kMaxParams = 4;
+
+    void push(PathSegment value);
+    void truncate(size_t count) { count_ = count < count_ ? count : count_; }
+    size_t size() const { return count_; }
+
+    // Segmento crudo, válido mientras viva el path de la request
+    PathSegment raw(size_t index) const;
+    std::optional<int> getInt(size_t index) const;
+    utility::string_t getString(size_t index) const;
+
+private:
+    std::array<PathSegment, kMaxParams> values_{};
+    size_t count_ = 0;
+};
+
+using RouteHandler = std::function<web::http::http_response(const web::http::http_request &,
+                                                            const RouteParams &,
+                                                            const DecodedUser &)>;
+
+// Handlers que devuelven una tarea (p. ej. los que esperan a PayPal)
+using AsyncRouteHandler = std::function<pplx::task<web::http::http_response>(const web::http::http_request &,
+                                                                             const RouteParams &,
+                                                                             const DecodedUser &)>;
+
+struct Route
+{
+    bool requiresAuth = false;
+    RouteHandler handler;
+    AsyncRouteHandler asyncHandler; // si está definido, se usa en lugar de handler
+};
+
+// Trie de segmentos: los segmentos estáticos se prueban antes que los parámetros,
+// y cada nodo guarda un handler por método HTTP.
+class RouteTable
+{
+public:
+    enum class Method
+    {
+        Get,
+        Post,
+        Put,
+        Delete,
+        Patch,
+        Count
+    };
+
+    RouteTable();
+    ~RouteTable();
+
+    // Patrón con segmentos estáticos y parámetros: "{name}" o "{name:int}"
+    void add(const web::http::method &method, const utility::string_t &pattern, Route route);
+
+    // Devuelve nullptr si ninguna ruta coincide con método y path
+    const Route *match(const web::http::method &method, PathSegment path, RouteParams &params) const;
+
+    static std::optional<Method> toMethod(const web::http::method &method);
+
+private:
+    struct Node;
+    const Route *matchNode(const Node &node, Method method, PathSegment rest, RouteParams &params) const;
+
+    std::unique_ptr<Node> root_;
+};
+
+#endif
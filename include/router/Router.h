@@ -13,6 +13,7 @@
 #include "controllers/CarrierController.h"
 #include "controllers/CategoryController.h"
 #include "middleware/AuthMiddleware.h"
+#include "router/RouteTable.h"
 
 
 class Router
@@ -22,7 +23,11 @@ public:
     void setup_routes();
 
 private:
+    void register_routes();
+    pplx::task<web::http::http_response> dispatch(const web::http::http_request &request) const;
+
     web::http::experimental::listener::http_listener &listener_;
+    RouteTable routes_;
 };
 
 #endif
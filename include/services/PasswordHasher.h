@@ -0,0 +1,109 @@
+#ifndef PASSWORDHASHER_H
+#define PASSWORDHASHER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pplx/pplxtasks.h>
+
+// Histograma de latencias en milisegundos con cubetas fijas
+class LatencyHistogram
+{
+public:
+    static constexpr std::array<uint64_t, 8> kBoundsMs = {10, 25, 50, 100, 250, 500, 1000, 2500};
+
+    void record(std::chrono::steady_clock::duration elapsed);
+
+    // Una cuenta por cubeta; la última es "> 2500 ms"
+    std::array<uint64_t, kBoundsMs.size() + 1> counts() const;
+    uint64_t total() const { return total_.load(); }
+
+private:
+    std::array<std::atomic<uint64_t>, kBoundsMs.size() + 1> buckets_{};
+    std::atomic<uint64_t> total_{0};
+};
+
+// Coste de Argon2: iteraciones (opslimit) y memoria en bytes (memlimit)
+struct HashParams
+{
+    unsigned long long opsLimit = 0;
+    size_t memLimit = 0;
+};
+
+// Resultado de verificar: needsRehash indica que el hash guardado se creó
+// con otros parámetros y conviene regenerarlo con los actuales
+struct VerifyResult
+{
+    bool matches = false;
+    bool needsRehash = false;
+};
+
+// Ejecutor dedicado para Argon2 (crypto_pwhash). Usa pocos hilos propios,
+// limitados también por un presupuesto de memoria, para que el hashing no
+// ocupe los workers de pplx ni dispare el consumo de RAM. Si la cola está
+// llena la operación se rechaza y el controlador responde 503.
+class PasswordHasher
+{
+public:
+    struct Stats
+    {
+        size_t workers = 0;
+        size_t queued = 0;
+        uint64_t rejected = 0;
+        std::array<uint64_t, LatencyHistogram::kBoundsMs.size() + 1> hashLatency{};
+        std::array<uint64_t, LatencyHistogram::kBoundsMs.size() + 1> verifyLatency{};
+    };
+
+    static PasswordHasher &getInstance();
+
+    PasswordHasher(size_t workers, size_t maxQueue, size_t memoryBudgetBytes, HashParams params);
+    ~PasswordHasher();
+
+    // nullopt si la cola está llena. La tarea devuelve el hash, o nullopt si falla
+    std::optional<pplx::task<std::optional<std::string>>> hash(std::string password);
+
+    // nullopt si la cola está llena
+    std::optional<pplx::task<VerifyResult>> verify(std::string storedHash, std::string password);
+
+    const HashParams &params() const { return params_; }
+    Stats stats() const;
+
+    // Perfiles: "interactive", "moderate", "sensitive", "custom" (opsLimit/memLimit
+    // dados) o "auto" (calibrado al arrancar para tardar unos targetMs por hash)
+    static HashParams resolveProfile(const std::string &profile, unsigned long long opsLimit,
+                                     size_t memLimit, std::chrono::milliseconds target);
+
+    // Sube opslimit con memLimit fijo hasta que un hash tarde al menos target
+    static HashParams calibrate(size_t memLimit, std::chrono::milliseconds target);
+
+    PasswordHasher(const PasswordHasher &) = delete;
+    PasswordHasher &operator=(const PasswordHasher &) = delete;
+
+private:
+    bool submit(std::function<void()> job);
+    void run();
+
+    const size_t maxQueue_;
+    const HashParams params_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::function<void()>> queue_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+
+    std::atomic<uint64_t> rejected_{0};
+    LatencyHistogram hashLatency_;
+    LatencyHistogram verifyLatency_;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef PAYPALSERVICE_H
 #define PAYPALSERVICE_H
 #include "utils/UtilsOwner.h"
+#include "utils/Money.h"
 #include <cpprest/http_client.h>
 #include <cpprest/json.h>
 #include "PaypalService.h"
@@ -8,6 +9,8 @@
 #include <sstream>
 #include <iomanip>
 #include <utility>
+#include <optional>
+#include "services/PaypalTokenCache.h"
 #include "db/DatabaseConnection.h"
 
 using namespace web;
@@ -18,9 +21,18 @@ class PaypalService
 {
 public:
     PaypalService();
-    http_response createPayment(const std::string &total, const std::string &idempotencyKey);
-    std::string getAccessToken();
-    http_response capturePayment(const std::string &orderId);
+    // Las llamadas devuelven tareas: ningún worker se queda bloqueado esperando a PayPal
+    pplx::task<http_response> createPayment(const Money &total, const std::string &idempotencyKey,
+                                            const pplx::cancellation_token &cancel = pplx::cancellation_token::none());
+    // Token OAuth cacheado (ver PaypalTokenCache)
+    pplx::task<std::string> getAccessToken();
+    // Pide un token nuevo a /v1/oauth2/token
+    static pplx::task<std::optional<PaypalAccessToken>> requestAccessToken();
+    pplx::task<http_response> capturePayment(const std::string &orderId,
+                                             const pplx::cancellation_token &cancel = pplx::cancellation_token::none());
+
+private:
+    static http_client &clientFor(const std::string &baseUrl);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef PAYPALTOKENCACHE_H
+#define PAYPALTOKENCACHE_H
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <pplx/pplxtasks.h>
+
+// Respuesta de /v1/oauth2/token
+struct PaypalAccessToken
+{
+    std::string accessToken;
+    std::chrono::seconds expiresIn{0};
+};
+
+// Caché del access token OAuth de PayPal. El token se reutiliza hasta
+// expires_in; dentro del margen de refresco se renueva en segundo plano
+// mientras se sigue sirviendo el actual. Solo hay una petición de token en
+// vuelo: las llamadas concurrentes encadenan sobre la misma tarea.
+class PaypalTokenCache
+{
+public:
+    using Fetcher = std::function<pplx::task<std::optional<PaypalAccessToken>>()>;
+
+    static PaypalTokenCache &getInstance();
+
+    PaypalTokenCache(Fetcher fetcher, std::chrono::seconds refreshMargin);
+
+    // Token vigente; cadena vacía si PayPal no devolvió ninguno
+    pplx::task<std::string> get();
+
+    // Descarta el token actual (p. ej. tras un 401 de PayPal)
+    void invalidate();
+
+    PaypalTokenCache(const PaypalTokenCache &) = delete;
+    PaypalTokenCache &operator=(const PaypalTokenCache &) = delete;
+
+private:
+    // Llamar con mutex_ tomado
+    pplx::task<void> startRefresh();
+    std::string currentToken();
+
+    // Vida asumida si la respuesta no trae expires_in (o trae 0): corta para
+    // no servir un token caducado mucho tiempo, pero sin pedir uno por llamada
+    static constexpr std::chrono::seconds kFallbackExpiresIn{300};
+
+    const Fetcher fetcher_;
+    const std::chrono::seconds refreshMargin_;
+
+    std::mutex mutex_;
+    std::optional<pplx::task<void>> inflight_;
+    std::string token_;
+    std::chrono::steady_clock::time_point expiresAt_;
+};
+
+#endif
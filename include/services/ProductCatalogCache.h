@@ -0,0 +1,53 @@
+#ifndef PRODUCTCATALOGCACHE_H
+#define PRODUCTCATALOGCACHE_H
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <cpprest/json.h>
+#include "entities/OrderItem.h"
+#include "entities/Product.h"
+#include "utils/Errors.h"
+#include "utils/Money.h"
+#include "utils/SnapshotCache.h"
+
+// Foto inmutable del catálogo: productos y el JSON de /products ya serializado
+struct ProductCatalogSnapshot
+{
+    std::vector<Product> products;
+    utility::string_t body;
+    // Índice id -> precio: el precio que manda al crear pedidos
+    std::unordered_map<int, Money> prices;
+};
+
+// Caché de solo lectura del catálogo. Los lectores copian un shared_ptr a la
+// foto actual; una recarga construye una foto nueva y la publica de golpe.
+class ProductCatalogCache
+{
+public:
+    static ProductCatalogCache &getInstance();
+
+    // nullptr solo si nunca se pudo cargar el catálogo
+    std::shared_ptr<const ProductCatalogSnapshot> get();
+
+    // Marca la foto actual como obsoleta; la siguiente lectura recarga
+    void invalidate();
+
+    // Sustituye el precio de cada línea por el del catálogo. NoRowsFound si
+    // algún producto no existe; DatabaseConnectionFailed si no hay catálogo.
+    Errors applyPrices(std::vector<OrderItem> &items);
+
+    ProductCatalogCache(const ProductCatalogCache &) = delete;
+    ProductCatalogCache &operator=(const ProductCatalogCache &) = delete;
+
+private:
+    explicit ProductCatalogCache(std::chrono::seconds ttl);
+
+    static std::optional<ProductCatalogSnapshot> load();
+
+    SnapshotCache<ProductCatalogSnapshot> cache_;
+};
+
+#endif
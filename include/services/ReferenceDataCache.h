@@ -0,0 +1,50 @@
+#ifndef REFERENCEDATACACHE_H
+#define REFERENCEDATACACHE_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <cpprest/http_msg.h>
+#include "utils/SnapshotCache.h"
+
+// Respuesta ya serializada con su ETag fuerte
+struct CachedBody
+{
+    utility::string_t body;
+    utility::string_t etag;
+};
+
+// Caché para datos de referencia pequeños que casi no cambian (carriers, categorías).
+// Responde If-None-Match con 304 sin construir el cuerpo y añade Cache-Control: max-age.
+class ReferenceDataCache
+{
+public:
+    // Devuelve el JSON serializado, o nullopt si falló la carga
+    using Loader = std::function<std::optional<utility::string_t>()>;
+
+    ReferenceDataCache(Loader loader, std::chrono::seconds ttl);
+
+    static ReferenceDataCache &carriers();
+    static ReferenceDataCache &categories();
+
+    // nullptr solo si nunca se pudo cargar
+    std::shared_ptr<const CachedBody> get();
+
+    // Marca la foto actual como obsoleta; la siguiente lectura recarga
+    void invalidate();
+
+    // 200 con cuerpo, 304 si el ETag coincide, o nullopt si no hay datos
+    std::optional<web::http::http_response> respond(const web::http::http_request &request);
+
+    ReferenceDataCache(const ReferenceDataCache &) = delete;
+    ReferenceDataCache &operator=(const ReferenceDataCache &) = delete;
+
+private:
+    bool matchesEtag(const utility::string_t &ifNoneMatch, const utility::string_t &etag) const;
+
+    utility::string_t cacheControl_;
+    SnapshotCache<CachedBody> cache_;
+};
+
+#endif
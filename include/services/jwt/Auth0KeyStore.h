@@ -0,0 +1,68 @@
+#ifndef AUTH0_KEY_STORE_H
+#define AUTH0_KEY_STORE_H
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <jwt-cpp/jwt.h>
+#include "entities/DecodedUser.h"
+
+// Claves públicas de Auth0 cargadas una sola vez, con un verificador RS256
+// ya construido por clave. El PEM de config/ es la clave por defecto; un
+// fichero local en formato JWKS (AUTH0_JWKS_PATH) añade claves por `kid`.
+// Los ficheros se vuelven a leer si cambia su fecha de modificación.
+// Las claves se publican como una foto inmutable: verificar no toma locks.
+class Auth0KeyStore
+{
+public:
+    using Verifier = decltype(jwt::verify());
+    using Decoded = decltype(jwt::decode(std::string()));
+
+    static Auth0KeyStore &getInstance();
+
+    // Verifica firma, issuer, audiencia y expiración; lanza si el token no es válido
+    DecodedUser verifyAndExtractUser(const std::string &token);
+    DecodedUser verifyAndExtractUser(const Decoded &decoded);
+
+    // Fuerza la recarga de las claves desde disco
+    bool reload();
+
+    Auth0KeyStore(const Auth0KeyStore &) = delete;
+    Auth0KeyStore &operator=(const Auth0KeyStore &) = delete;
+
+private:
+    struct KeySet
+    {
+        std::optional<Verifier> defaultVerifier;
+        std::unordered_map<std::string, Verifier> byKid;
+        std::filesystem::file_time_type pemWriteTime{};
+        std::filesystem::file_time_type jwksWriteTime{};
+    };
+
+    Auth0KeyStore(std::string pemPath, std::string jwksPath, std::string audience,
+                  std::string issuer, std::chrono::seconds reloadInterval);
+
+    std::shared_ptr<const KeySet> current();
+    std::shared_ptr<const KeySet> load() const;
+    Verifier buildVerifier(const std::string &publicKeyPem) const;
+    bool filesChanged(const KeySet &keys) const;
+
+    const std::string pemPath_;
+    const std::string jwksPath_;
+    const std::string audience_;
+    const std::string issuer_;
+    const std::chrono::seconds reloadInterval_;
+
+    std::atomic<std::shared_ptr<const KeySet>> keys_;
+    // Próxima comprobación de los ficheros, en ticks de steady_clock
+    std::atomic<std::chrono::steady_clock::rep> nextCheck_{0};
+
+    std::mutex reloadMutex_; // una sola comprobación/recarga a la vez
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define JWT_SERVICE_H
 #include <optional>
 #include <string>
+#include <jwt-cpp/jwt.h>
 #include "entities/DecodedUser.h"
 
 class JwtService
@@ -9,7 +10,9 @@ class JwtService
 public:
     static std::string generateToken(const std::string &user_id, const std::string &email);
     static std::optional<std::string> decodeToken(const std::string &token);
-    static std::optional<DecodedUser> verifyAndExtractUser(const std::string& token);   
+    static std::optional<DecodedUser> verifyAndExtractUser(const std::string& token);
+    // Para tokens ya decodificados (el middleware decodifica una sola vez)
+    static std::optional<DecodedUser> verifyAndExtractUser(const decltype(jwt::decode(std::string())) &decoded);
 };
 
 #endif
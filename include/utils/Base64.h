@@ -0,0 +1,30 @@
+#ifndef BASE64_H
+#define BASE64_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Base64 y base64url (RFC 4648). Los bloques completos se procesan con
+// SSE4.1 o AVX2 cuando la CPU los tiene (se detecta una vez al arrancar);
+// las colas y el resto de plataformas usan la versión escalar.
+class Base64
+{
+public:
+    enum class Alphabet
+    {
+        Standard, // '+' '/', con relleno '='
+        Url       // '-' '_', sin relleno (JWT)
+    };
+
+    static std::string encode(std::string_view input, Alphabet alphabet = Alphabet::Standard);
+
+    // nullopt si hay caracteres fuera del alfabeto o la longitud no es válida.
+    // En Url el relleno '=' es opcional.
+    static std::optional<std::string> decode(std::string_view input, Alphabet alphabet = Alphabet::Standard);
+
+    // "avx2", "sse4.1" o "scalar"
+    static const char *implementation();
+};
+
+#endif // BASE64_H
@@ -0,0 +1,27 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <chrono>
+#include <pplx/pplxtasks.h>
+
+// Plazo máximo de una petición. Al vencer cancela su token, de modo que las
+// llamadas HTTP que lo reciben se abortan y las continuaciones pendientes
+// terminan con pplx::task_canceled. Un único hilo temporizador atiende todos
+// los plazos, así que ningún worker queda dormido esperando.
+class Deadline
+{
+public:
+    explicit Deadline(std::chrono::milliseconds budget);
+
+    pplx::cancellation_token token() const { return source_.get_token(); }
+    bool expired() const;
+
+    // Lanza pplx::task_canceled si el plazo ya venció; llamar entre pasos
+    void check() const;
+
+private:
+    std::chrono::steady_clock::time_point at_;
+    pplx::cancellation_token_source source_;
+};
+
+#endif // DEADLINE_H
@@ -16,5 +16,8 @@ enum class Errors
     FetchFailed,
     CommitFailed,
     UnknownError,
-    BindResultFailed
+    BindResultFailed,
+    NotOwner,
+    InvalidArgument,
+    InvalidState // la fila existe pero su estado no admite el cambio
 };
\ No newline at end of file
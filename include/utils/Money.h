@@ -0,0 +1,168 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+enum class Currency : uint8_t
+{
+    EUR
+};
+
+constexpr std::string_view currencyCode(Currency currency)
+{
+    switch (currency)
+    {
+    case Currency::EUR:
+        return "EUR";
+    }
+    return "";
+}
+
+// Importe exacto en unidades menores (céntimos) con su moneda. Sustituye a
+// double en pedidos, líneas, transportistas e intentos de pago: MySQL guarda
+// DECIMAL(10,2) y aquí se opera sin redondeos intermedios.
+class Money
+{
+public:
+    // Texto con dos decimales en un buffer fijo; no reserva memoria
+    struct Formatted
+    {
+        std::array<char, 24> data{};
+        size_t size = 0;
+
+        std::string_view view() const { return {data.data(), size}; }
+        std::string str() const { return std::string(view()); }
+    };
+
+    constexpr Money() = default;
+
+    static constexpr Money fromMinor(int64_t minor, Currency currency = Currency::EUR)
+    {
+        return Money(minor, currency);
+    }
+
+    // Solo para fronteras que aún hablan en double (JSON de entrada, columnas antiguas)
+    static Money fromDouble(double value, Currency currency = Currency::EUR)
+    {
+        return Money(std::llround(value * 100.0), currency);
+    }
+
+    // Acepta "[-]123", "[-]123.4" y "[-]123.45", el formato de DECIMAL(10,2)
+    static constexpr std::optional<Money> parse(std::string_view text, Currency currency = Currency::EUR)
+    {
+        bool negative = !text.empty() && text.front() == '-';
+        if (negative)
+            text.remove_prefix(1);
+        if (text.empty())
+            return std::nullopt;
+
+        int64_t units = 0;
+        size_t i = 0;
+        for (; i < text.size() && text[i] != '.'; ++i)
+        {
+            if (text[i] < '0' || text[i] > '9' || units > (INT64_MAX - 9) / 1000)
+                return std::nullopt;
+            units = units * 10 + (text[i] - '0');
+        }
+
+        int64_t cents = 0;
+        if (i < text.size())
+        {
+            std::string_view fraction = text.substr(i + 1);
+            if (fraction.size() > 2)
+                return std::nullopt;
+            for (char c : fraction)
+            {
+                if (c < '0' || c > '9')
+                    return std::nullopt;
+                cents = cents * 10 + (c - '0');
+            }
+            if (fraction.size() == 1)
+                cents *= 10;
+        }
+
+        int64_t minor = units * 100 + cents;
+        return Money(negative ? -minor : minor, currency);
+    }
+
+    constexpr int64_t minor() const { return minor_; }
+    constexpr Currency currency() const { return currency_; }
+    constexpr bool isZero() const { return minor_ == 0; }
+
+    // Para respuestas JSON; no usar para operar
+    constexpr double toDouble() const { return static_cast<double>(minor_) / 100.0; }
+
+    Formatted format() const
+    {
+        Formatted out;
+        char *p = out.data.data();
+        char *end = p + out.data.size();
+        uint64_t magnitude = minor_ < 0 ? 0 - static_cast<uint64_t>(minor_) : static_cast<uint64_t>(minor_);
+        if (minor_ < 0)
+            *p++ = '-';
+        p = std::to_chars(p, end, magnitude / 100).ptr;
+        uint64_t cents = magnitude % 100;
+        *p++ = '.';
+        *p++ = static_cast<char>('0' + cents / 10);
+        *p++ = static_cast<char>('0' + cents % 10);
+        out.size = static_cast<size_t>(p - out.data.data());
+        return out;
+    }
+
+    std::string toString() const { return format().str(); }
+
+    constexpr Money &operator+=(const Money &other)
+    {
+        checkCurrency(other);
+        minor_ += other.minor_;
+        return *this;
+    }
+    constexpr Money &operator-=(const Money &other)
+    {
+        checkCurrency(other);
+        minor_ -= other.minor_;
+        return *this;
+    }
+
+    friend constexpr Money operator+(Money lhs, const Money &rhs) { return lhs += rhs; }
+    friend constexpr Money operator-(Money lhs, const Money &rhs) { return lhs -= rhs; }
+    friend constexpr Money operator*(Money lhs, int64_t quantity)
+    {
+        lhs.minor_ *= quantity;
+        return lhs;
+    }
+    friend constexpr Money operator*(int64_t quantity, Money rhs) { return rhs * quantity; }
+
+    friend constexpr bool operator==(const Money &, const Money &) = default;
+    friend constexpr std::strong_ordering operator<=>(const Money &lhs, const Money &rhs)
+    {
+        lhs.checkCurrency(rhs);
+        return lhs.minor_ <=> rhs.minor_;
+    }
+
+private:
+    constexpr Money(int64_t minor, Currency currency) : minor_(minor), currency_(currency) {}
+
+    constexpr void checkCurrency(const Money &other) const
+    {
+        if (currency_ != other.currency_)
+            throw std::logic_error("Money: currency mismatch");
+    }
+
+    int64_t minor_ = 0;
+    Currency currency_ = Currency::EUR;
+};
+
+static_assert(Money::fromMinor(1999) * 3 == Money::fromMinor(5997));
+static_assert(Money::parse("12.3")->minor() == 1230);
+static_assert(Money::parse("-0.05")->minor() == -5);
+
+#endif // MONEY_H
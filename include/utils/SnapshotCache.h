@@ -0,0 +1,113 @@
+#ifndef SNAPSHOTCACHE_H
+#define SNAPSHOTCACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Foto inmutable de T que se recarga por TTL o al invalidarla. Los lectores
+// solo copian un shared_ptr; la recarga corre fuera de ese lock y la hace un
+// único hilo mientras el resto sigue sirviendo la foto anterior. Solo se
+// espera a la carga cuando todavía no hay ninguna foto.
+//
+// Loader devuelve el valor nuevo, o nullopt si la carga falló.
+template <typename T, typename Loader = std::function<std::optional<T>()>>
+class SnapshotCache
+{
+public:
+    SnapshotCache(Loader loader, std::chrono::seconds ttl) : loader_(std::move(loader)), ttl_(ttl) {}
+
+    // nullptr solo si nunca se pudo cargar
+    std::shared_ptr<const T> get()
+    {
+        std::shared_ptr<const Entry> current;
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex_);
+            current = entry_;
+        }
+
+        if (current && !isStale(*current))
+            return view(current);
+
+        if (!current)
+        {
+            std::lock_guard<std::mutex> lock(refreshMutex_);
+            return view(refresh());
+        }
+
+        std::unique_lock<std::mutex> lock(refreshMutex_, std::try_to_lock);
+        if (!lock.owns_lock())
+            return view(current);
+        auto fresh = refresh();
+        return view(fresh ? fresh : current); // si falla la recarga, lo último que haya
+    }
+
+    // Marca la foto actual como obsoleta; la siguiente lectura recarga
+    void invalidate()
+    {
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    SnapshotCache(const SnapshotCache &) = delete;
+    SnapshotCache &operator=(const SnapshotCache &) = delete;
+
+private:
+    struct Entry
+    {
+        T value;
+        uint64_t generation;
+        std::chrono::steady_clock::time_point loadedAt;
+    };
+
+    static std::shared_ptr<const T> view(const std::shared_ptr<const Entry> &entry)
+    {
+        if (!entry)
+            return nullptr;
+        return std::shared_ptr<const T>(entry, &entry->value);
+    }
+
+    bool isStale(const Entry &entry) const
+    {
+        return entry.generation != generation_.load(std::memory_order_acquire) ||
+               std::chrono::steady_clock::now() - entry.loadedAt >= ttl_;
+    }
+
+    // Llamar con refreshMutex_ tomado
+    std::shared_ptr<const Entry> refresh()
+    {
+        {
+            // Otro hilo pudo haber recargado mientras esperábamos
+            std::lock_guard<std::mutex> lock(snapshotMutex_);
+            if (entry_ && !isStale(*entry_))
+                return entry_;
+        }
+
+        // La generación se lee antes de cargar: una invalidación durante la
+        // carga deja la foto nueva ya obsoleta
+        uint64_t generation = generation_.load(std::memory_order_acquire);
+        std::optional<T> value = loader_();
+        if (!value.has_value())
+            return nullptr;
+
+        auto fresh = std::make_shared<const Entry>(Entry{std::move(*value), generation, std::chrono::steady_clock::now()});
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        entry_ = fresh;
+        return fresh;
+    }
+
+    Loader loader_;
+    const std::chrono::seconds ttl_;
+    std::atomic<uint64_t> generation_{0};
+
+    std::mutex snapshotMutex_; // solo protege la copia del puntero
+    std::shared_ptr<const Entry> entry_;
+
+    std::mutex refreshMutex_; // una sola recarga a la vez
+};
+
+#endif // SNAPSHOTCACHE_H
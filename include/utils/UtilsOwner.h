@@ -2,6 +2,7 @@
 #define UTILSOWNER_H
 #include <iostream>
 #include <string>
+#include <optional>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -9,6 +10,7 @@
 #include <openssl/sha.h>
 #include <vector>
 #include "entities/OrderItem.h"
+#include "utils/Money.h"
 #include <algorithm>  
 #include <openssl/evp.h>
 
@@ -18,9 +20,9 @@ class UtilsOwner
 {
 public:
     static auto base64_encode(const std::string &input) -> std::string;
-    static auto roundToTwoDecimal(double value) -> double;
-    static auto toString2Dec(double value) -> std::string;
+    static auto base64_decode(const std::string &input) -> std::optional<std::string>;
     static auto generateUuid() -> std::string;
-    static std::string hashCart(int order_id, double total, const std::vector<OrderItem> &items);
+    static std::string hashCart(int order_id, const Money &total, const std::vector<OrderItem> &items);
+    static std::string sha256Hex(const std::string &data);
 };
 #endif // UTILSSOWNER_H
\ No newline at end of file
@@ -4,7 +4,8 @@
 #include "db/DatabaseConnection.h"
 #include "controllers/AuthController.h"
 #include "server/Server.h"
-#include "env/EnvLoader.h"
+#include "env/Config.h"
+#include "services/PasswordHasher.h"
 #include <iostream>
 #include <cpprest/http_listener.h>
 #include <cpprest/json.h>
@@ -19,9 +20,9 @@ using namespace std;
 
 int main()
 {
-
-    EnvLoader env(".env");
-    env.load();
+    // Antes de crear hilos: SIGHUP recarga la configuración
+    Config::watchReloadSignal();
+    const Config &config = Config::get();
 
     // Load hashed function
     if (sodium_init() < 0)
@@ -29,14 +30,10 @@ int main()
         std::cerr << "Error inicializando libsodium" << std::endl;
         return 1;
     }
+    // Resuelve el perfil de Argon2 (y calibra si es "auto") antes de aceptar peticiones
+    PasswordHasher::getInstance();
 
-    // Leer las variables
-    string host = env.get("DB_HOST", "localhost"); // Valor por defecto si no está en .env
-    string user = env.get("DB_USER", "root");
-    string password = env.get("DB_PASSWORD", "");
-    string dbname = env.get("DB_NAME", "tienda_del_alma");
-    unsigned int port = stoi(env.get("DB_PORT", "3306"));
-    utility::string_t server_address = U(env.get("SERVER_ADDRESS", "http://localhost:8080"));
+    utility::string_t server_address = U(config.serverAddress);
 
     DatabaseInitializer dbInitializer;
     if (!dbInitializer.initialize(true))
@@ -7,200 +7,173 @@ using namespace web::http::client;
 
 AuthController::AuthController() : userController() {}
 
-http_response AuthController::signup(const http_request &request)
+namespace
 {
-    // Creación de una respuesta predeterminada, que se completará al final del proceso
-    http_response response(status_codes::OK);
-    EnvLoader env(".env");
-    env.load(); // Cargar el archivo .env
-
-    // Este futuro representará la ejecución asincrónica de la lógica de signup
-    std::future<void> signup_future = std::async(std::launch::async, [request, &response, &env, this]()
-                                                 {
-                                                     // Extraer el cuerpo JSON de la solicitud
-                                                     request.extract_json()
-                                                         .then([&response, &env, this](json::value body)
-                                                               {
-                try {
-                    // Verificar que el cuerpo sea un objeto JSON válido
-                    if (body.is_object()) {
-                        // Extraer los campos del JSON
-                        auto first_name = utility::conversions::to_utf8string(body.at(U("first_name")).as_string());
-                        std::string password = body.at(U("password")).as_string();
-                        auto email = utility::conversions::to_utf8string(body.at(U("email")).as_string());
-
-                        char hashed[crypto_pwhash_STRBYTES];
-
-                        if (crypto_pwhash_str(hashed, password.c_str(), password.size(),
-                                              crypto_pwhash_OPSLIMIT_MODERATE,
-                                              crypto_pwhash_MEMLIMIT_MODERATE) != 0)
-                        {
-                            std::cerr << "Error al generar el hash" << std::endl;
-                            response.set_status_code(status_codes::InternalError);
-                            response.set_body(json::value::object({{U("error"), json::value::string(U("Error al generar el hash de la contraseña"))}}));
-                            return; // exit lambda
-                        }
-                        // Verificar si el usuario ya existe
-                        auto userOpt = this->userController.getUserByEmail(email);
-                         std::optional<int> user_id;
-                        if (!userOpt.has_value())
-                        {
-                            // El usuario NO existe → crear nuevo usuario
-                            user_id = this->userController.createUser(first_name, hashed, email, "local", "");  
-                            std::cout<<user_id.value()<<std::endl;    
-                        }else {}
-                        // Llamar al controlador de usuarios
-                        if (user_id.has_value()) {
-                            std::string secret = env.get("JWT_SECRET", "");
-                            if (secret.empty())
-                            {
-                                std::cerr << "Error: JWT_SECRET no está configurado correctamente." << std::endl;
-                                response.set_status_code(status_codes::InternalError);
-                                response.set_body(json::value::object({
-                                    {U("error"), json::value::string(U("JWT_SECRET no está configurado correctamente"))}
-                                }));
-                                return;
-                            }
-
-                            auto token = JwtService::generateToken(std::to_string(user_id.value()), email);
-                            response.headers().add(U("X-Token"), utility::conversions::to_string_t(token));
-                            response.set_status_code(status_codes::Created); // 201 Created
-                            response.set_body(json::value::object({{U("message"), json::value::string(U("Usuario creado exitosamente"))},
-                                                                   {U("token"), json::value::string(utility::conversions::to_string_t(token))}}));
-                        } else {
-                            response.set_status_code(status_codes::InternalError); // 500
-                            response.set_body(json::value::object({
-                                {U("error"), json::value::string(U("Error al crear usuario"))}
-                            }));
-                        }
-                    } else {
-                        response.set_status_code(status_codes::BadRequest); // 400
-                        response.set_body(json::value::object({
-                            {U("error"), json::value::string(U("Cuerpo JSON inválido"))}
-                        }));
-                    }
-                } catch (const json::json_exception &e) {
-                    response.set_status_code(status_codes::BadRequest); // 400
-                    response.set_body(json::value::object({
-                        {U("error"), json::value::string(U("Error al procesar JSON: ") + utility::conversions::to_string_t(e.what()))}
-                    }));
-                } })
-                                                         .wait(); // Usamos `wait()` solo dentro de la ejecución asincrónica, no bloqueando el hilo principal
-                                                 });
-
-    // Esperamos a que se complete el futuro antes de retornar
-    signup_future.wait(); // Bloquea solo la parte del código que necesita esperar el resultado
-
-    return response; // Esto se ejecuta cuando el futuro ha completado su trabajo
+    http_response jsonError(status_code status, const utility::string_t &message)
+    {
+        http_response response(status);
+        response.set_body(json::value::object({{U("error"), json::value::string(message)}}));
+        return response;
+    }
+
+    // Cola de hashing llena: el cliente debe reintentar más tarde
+    pplx::task<http_response> hasherBusy()
+    {
+        http_response response = jsonError(status_codes::ServiceUnavailable, U("Servidor ocupado, inténtalo de nuevo"));
+        response.headers().add(U("Retry-After"), std::to_string(Config::get().passwordHashRetryAfter.count()));
+        return pplx::task_from_result(response);
+    }
+
+    http_response invalidJson(const json::json_exception &e)
+    {
+        return jsonError(status_codes::BadRequest, U("Error al procesar JSON: ") + utility::conversions::to_string_t(e.what()));
+    }
 }
 
-http_response AuthController::login(const http_request &request)
+// Best effort: si la cola está llena o falla, se reintentará en el próximo login
+void AuthController::rehashPassword(int user_id, const std::string &password)
 {
-    // Respuesta predeterminada
-    http_response response(status_codes::OK);
-    EnvLoader env(".env");
-    env.load(); // Cargar variables de entorno
-
-    // Ejecutar la lógica de login de forma asíncrona
-    std::future<void> login_future = std::async(std::launch::async, [request, &response, &env, this]()
-                                                {
-                                                    // Extraer el cuerpo JSON del request
-                                                    request.extract_json().then([&response, &env, this](json::value body)
-                                                                                {
-            try {
-                if (body.is_object())
+    auto hashTask = PasswordHasher::getInstance().hash(password);
+    if (!hashTask.has_value())
+    {
+        return;
+    }
+    hashTask->then([this, user_id](std::optional<std::string> hashed)
+                   {
+        if (hashed.has_value() && this->userController.updatePassword(user_id, hashed.value()))
+        {
+            std::cout << "Contraseña rehasheada con los parámetros actuales. Usuario: " << user_id << std::endl;
+        } });
+}
+
+pplx::task<http_response> AuthController::signup(const http_request &request)
+{
+    // Sin hilos extra: la lógica corre como continuación cuando llega el cuerpo JSON;
+    // Argon2 se ejecuta en el PasswordHasher, fuera de los workers de pplx
+    return request.extract_json().then([this](pplx::task<json::value> bodyTask)
+                                       {
+        try {
+            json::value body = bodyTask.get();
+            // Verificar que el cuerpo sea un objeto JSON válido
+            if (!body.is_object()) {
+                return pplx::task_from_result(jsonError(status_codes::BadRequest, U("Cuerpo JSON inválido")));
+            }
+            // Extraer los campos del JSON
+            auto first_name = utility::conversions::to_utf8string(body.at(U("first_name")).as_string());
+            std::string password = body.at(U("password")).as_string();
+            auto email = utility::conversions::to_utf8string(body.at(U("email")).as_string());
+
+            auto hashTask = PasswordHasher::getInstance().hash(std::move(password));
+            if (!hashTask.has_value()) {
+                return hasherBusy();
+            }
+
+            return hashTask->then([this, first_name, email](std::optional<std::string> hashed)
+                                  {
+                if (!hashed.has_value())
                 {
-                    // Extraer email y password del JSON
-                    auto email = utility::conversions::to_utf8string(body.at(U("email")).as_string());
-                    int user_id;
-                    std::string password = body.at(U("password")).as_string();
-
-                    // Usamos el controlador de usuarios para buscar el usuario por email.
-                    // Asegúrate de tener implementado getUserByEmail en UserController.
-                    auto userOpt = this->userController.getUserByEmail(email);
-                    
-                    if (!userOpt.has_value()) {
-                        response.set_status_code(status_codes::Unauthorized);
-                        response.set_body(json::value::object({
-                            {U("error"), json::value::string(U("Usuario no encontrado"))}
-                        }));
-                        return;
-                    }else {
-                                    auto user = userOpt.value();
-
-                                    if (user.auth_provider != "local") {
-                                        // Conflicto: cuenta ya existe con otro método de login
-                                        response.set_status_code(status_codes::Conflict); // 409
-                                        response.set_body(json::value::object({
-                                            {U("error"), json::value::string(U("Este email ya está registrado con otro método de autenticación. Inicia sesión con tu contraseña."))}
-                                        }));
-                                        return;
-                                    }
-
-                                
-
-                                    user_id = user.id;
-                                }
-                    
-                    auto user = userOpt.value();
-                    // Verificar la contraseña usando libsodium
-                    if (crypto_pwhash_str_verify(user.password.c_str(), password.c_str(), password.size()) != 0)
-                    {
-                        response.set_status_code(status_codes::Unauthorized);
-                        response.set_body(json::value::object({
-                            {U("error"), json::value::string(U("Contraseña incorrecta"))}
-                        }));
-                        return;
-                    }
-
-                    // Si el login es exitoso, generar un token JWT
-                    std::string secret = env.get("JWT_SECRET", "");
-                    if (secret.empty())
-                    {
-                        response.set_status_code(status_codes::InternalError);
-                        response.set_body(json::value::object({
-                            {U("error"), json::value::string(U("JWT_SECRET no está configurado correctamente"))}
-                        }));
-                        return;
-                    }
-
-                    auto token = JwtService::generateToken(std::to_string(user.id), user.email);
-                    response.headers().add(U("X-Token"), utility::conversions::to_string_t(token));
-                    response.set_status_code(status_codes::OK);
-                    response.set_body(json::value::object({
-                        {U("message"), json::value::string(U("Login exitoso"))},
-                        {U("token"), json::value::string(utility::conversions::to_string_t(token))}
-                    }));
+                    std::cerr << "Error al generar el hash" << std::endl;
+                    return jsonError(status_codes::InternalError, U("Error al generar el hash de la contraseña"));
                 }
-                else
+                // Verificar si el usuario ya existe
+                auto userOpt = this->userController.getUserByEmail(email);
+                std::optional<int> user_id;
+                if (!userOpt.has_value())
                 {
-                    response.set_status_code(status_codes::BadRequest);
-                    response.set_body(json::value::object({
-                        {U("error"), json::value::string(U("Cuerpo JSON inválido"))}
-                    }));
+                    // El usuario NO existe → crear nuevo usuario
+                    user_id = this->userController.createUser(first_name, hashed.value(), email, "local", "");
                 }
-            }
-            catch (const json::json_exception &e)
+                if (!user_id.has_value()) {
+                    return jsonError(status_codes::InternalError, U("Error al crear usuario")); // 500
+                }
+                if (Config::get().jwtSecret.empty())
+                {
+                    std::cerr << "Error: JWT_SECRET no está configurado correctamente." << std::endl;
+                    return jsonError(status_codes::InternalError, U("JWT_SECRET no está configurado correctamente"));
+                }
+
+                http_response response(status_codes::Created); // 201 Created
+                auto token = JwtService::generateToken(std::to_string(user_id.value()), email);
+                response.headers().add(U("X-Token"), utility::conversions::to_string_t(token));
+                response.set_body(json::value::object({{U("message"), json::value::string(U("Usuario creado exitosamente"))},
+                                                       {U("token"), json::value::string(utility::conversions::to_string_t(token))}}));
+                return response; });
+        } catch (const json::json_exception &e) {
+            return pplx::task_from_result(invalidJson(e)); // 400
+        } });
+}
+
+pplx::task<http_response> AuthController::login(const http_request &request)
+{
+    // Sin hilos extra: la lógica corre como continuación cuando llega el cuerpo JSON;
+    // la verificación Argon2 se ejecuta en el PasswordHasher
+    return request.extract_json().then([this](pplx::task<json::value> bodyTask)
+                                       {
+        try {
+            json::value body = bodyTask.get();
+            if (!body.is_object())
             {
-                response.set_status_code(status_codes::BadRequest);
-                response.set_body(json::value::object({
-                    {U("error"), json::value::string(U("Error al procesar JSON: ") + utility::conversions::to_string_t(e.what()))}
-                }));
-            } })
-                                                        .wait(); // Esperamos a que se procese el JSON dentro del lambda
-                                                });
+                return pplx::task_from_result(jsonError(status_codes::BadRequest, U("Cuerpo JSON inválido")));
+            }
+
+            // Extraer email y password del JSON
+            auto email = utility::conversions::to_utf8string(body.at(U("email")).as_string());
+            std::string password = body.at(U("password")).as_string();
+
+            auto userOpt = this->userController.getUserByEmail(email);
+            if (!userOpt.has_value()) {
+                return pplx::task_from_result(jsonError(status_codes::Unauthorized, U("Usuario no encontrado")));
+            }
+            auto user = userOpt.value();
+            if (user.auth_provider != "local") {
+                // Conflicto: cuenta ya existe con otro método de login
+                return pplx::task_from_result(jsonError(status_codes::Conflict, // 409
+                                                        U("Este email ya está registrado con otro método de autenticación. Inicia sesión con tu contraseña.")));
+            }
+
+            // Verificar la contraseña usando libsodium
+            auto verifyTask = PasswordHasher::getInstance().verify(user.password, password);
+            if (!verifyTask.has_value()) {
+                return hasherBusy();
+            }
 
-    // Esperamos a que se complete el futuro antes de retornar la respuesta
-    login_future.wait();
+            return verifyTask->then([this, user, password](VerifyResult result)
+                                    {
+                if (!result.matches)
+                {
+                    return jsonError(status_codes::Unauthorized, U("Contraseña incorrecta"));
+                }
+
+                // Hash creado con parámetros antiguos: se regenera en segundo plano
+                if (result.needsRehash)
+                {
+                    rehashPassword(user.id, password);
+                }
+
+                // Si el login es exitoso, generar un token JWT
+                if (Config::get().jwtSecret.empty())
+                {
+                    return jsonError(status_codes::InternalError, U("JWT_SECRET no está configurado correctamente"));
+                }
 
-    return response;
+                http_response response(status_codes::OK);
+                auto token = JwtService::generateToken(std::to_string(user.id), user.email);
+                response.headers().add(U("X-Token"), utility::conversions::to_string_t(token));
+                response.set_body(json::value::object({
+                    {U("message"), json::value::string(U("Login exitoso"))},
+                    {U("token"), json::value::string(utility::conversions::to_string_t(token))}
+                }));
+                return response; });
+        }
+        catch (const json::json_exception &e)
+        {
+            return pplx::task_from_result(invalidJson(e));
+        } });
 }
 
 http_response AuthController::googleLogin(const http_request &request)
 {
     http_response response(status_codes::OK);
-    EnvLoader env(".env");
-    env.load();
 
     std::cout << "📥 [googleLogin] Entrando..." << std::endl;
 
@@ -217,16 +190,8 @@ http_response AuthController::googleLogin(const http_request &request)
         std::string id_token = utility::conversions::to_utf8string(body.at(U("id_token")).as_string());
         std::cout << "✅ [googleLogin] Token recibido" << std::endl;
 
-        // Leer clave pública desde archivo
-        std::string publicKeyPem = Auth0JwtUtils::readPemFile("config/auth0_public.pem");
-
-        // Verificar y extraer claims
-        auto decoded = Auth0JwtUtils::verifyAndExtractUser(
-            id_token,
-            publicKeyPem,
-            env.get("GOOGLE_CLIENT_ID"),
-            env.get("AUTH0_ISSUER")
-        );
+        // Verificar y extraer claims con las claves ya cargadas
+        auto decoded = Auth0KeyStore::getInstance().verifyAndExtractUser(id_token);
 
         std::string email = decoded.email;
         std::string sub = decoded.sub;
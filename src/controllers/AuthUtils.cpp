@@ -3,6 +3,16 @@
 
 
 std::optional<DecodedUser> AuthUtils::getUserFromRequest(const web::http::http_request &request)
+{
+    auto token = getTokenFromRequest(request);
+    if (token.has_value()) {
+        return JwtService::verifyAndExtractUser(token.value());
+    }
+    return std::nullopt;
+}
+
+// Token de sesión local guardado en la cookie "token"
+std::optional<std::string> AuthUtils::getTokenFromRequest(const web::http::http_request &request)
 {
     auto cookies_header = request.headers().find(U("Cookie"));
     if (cookies_header != request.headers().end()) {
@@ -16,7 +26,7 @@ std::optional<DecodedUser> AuthUtils::getUserFromRequest(const web::http::http_r
             }
             std::string token = cookies.substr(token_start, token_end - token_start);
             if (!token.empty()) {
-                return JwtService::verifyAndExtractUser(token);
+                return token;
             }
         }
     }
@@ -4,30 +4,14 @@ CarrierController::CarrierController() {}
 
 web::http::http_response CarrierController::getCarriers(const web::http::http_request &request)
 {
-    web::http::http_response response;
-
-    // get carriers
-    CarrierModel carrierModel;
-    auto [optCarriers, errors] = carrierModel.getAllCarriers();
-    if (!optCarriers.has_value())
-    {
-        response.set_status_code(web::http::status_codes::NotFound);
-        response.set_body(U("No carriers found"));
-        return response;
-    }
-
-    response.set_status_code(web::http::status_codes::OK);
+    // Carriers casi nunca cambian: se sirven serializados con ETag y Cache-Control
+    auto cached = ReferenceDataCache::carriers().respond(request);
+    if (cached.has_value())
+        return cached.value();
 
-    web::json::value json_response = web::json::value::array();
-    for (size_t i = 0; i < optCarriers->size(); ++i)
-    {
-        const auto &carrier = optCarriers->at(i);
-        json_response[i] = web::json::value::object();
-        json_response[i][U("id")] = web::json::value::number(carrier.id);
-        json_response[i][U("name")] = web::json::value::string(carrier.name);
-        json_response[i][U("price")] = web::json::value::number(carrier.price);
-    }
-    response.set_body(json_response);
+    web::http::http_response response;
+    response.set_status_code(web::http::status_codes::NotFound);
+    response.set_body(U("No carriers found"));
     return response;
 }
 
@@ -68,7 +52,7 @@ web::http::http_response CarrierController::getCarriers(const web::http::http_re
     web::json::value json_response = web::json::value::object();
     json_response[U("id")] = web::json::value::number(carrier.id);
     json_response[U("name")] = web::json::value::string(carrier.name);
-    json_response[U("price")] = web::json::value::number(carrier.price);
+    json_response[U("price")] = web::json::value::number(carrier.price.toDouble());
 
     response.set_status_code(web::http::status_codes::OK);
     response.set_body(json_response);
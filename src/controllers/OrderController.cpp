@@ -1,5 +1,7 @@
 #include "controllers/OrderController.h"
 #include "model/OrderModel.h" // Make sure to include the model
+#include "services/ProductCatalogCache.h"
+#include <unordered_set>
 
 OrderController::OrderController() {}
 
@@ -39,12 +41,21 @@ web::http::http_response OrderController::createOrder(const web::http::http_requ
     try
     {
         auto arr = body[U("products")].as_array();
+        // order_items guarda una línea por producto: con repetidos el total
+        // sumaría todas las líneas y la tabla solo conservaría la última
+        std::unordered_set<int> seen;
+        seen.reserve(arr.size());
         for (const auto &item : arr)
         {
             OrderItem prod;
             prod.product_id = item.at(U("id")).as_integer();
             prod.quantity = item.at(U("quantity")).as_integer();
-            prod.price = item.at(U("price")).as_double();
+            if (prod.quantity <= 0)
+                throw std::invalid_argument("quantity must be positive");
+            if (!seen.insert(prod.product_id).second)
+                throw std::invalid_argument("duplicate product");
+            // El precio del cliente se ignora: lo fija el catálogo más abajo
+            prod.price = Money();
             products.push_back(prod);
         }
     }
@@ -55,6 +66,21 @@ web::http::http_response OrderController::createOrder(const web::http::http_requ
         return response;
     }
 
+    // Precios desde el índice en memoria del catálogo, sin consultas extra
+    Errors priceError = ProductCatalogCache::getInstance().applyPrices(products);
+    if (priceError == Errors::NoRowsFound)
+    {
+        response.set_status_code(web::http::status_codes::BadRequest);
+        response.set_body(U("Invalid product data: unknown product"));
+        return response;
+    }
+    if (priceError != Errors::NoError)
+    {
+        response.set_status_code(web::http::status_codes::ServiceUnavailable);
+        response.set_body(U("Product catalog unavailable"));
+        return response;
+    }
+
     // 5. Optional fields (e.g., shipment date, delivery date, payment method, etc.)
     auto getOpt = [&](const utility::string_t &key)
     {
@@ -68,92 +94,38 @@ web::http::http_response OrderController::createOrder(const web::http::http_requ
     std::string payment_method = getOpt(U("payment_method"));
     std::string payment_status = getOpt(U("payment_status"));
 
-    // 6. Call the model to create or update the order
-    OrderModel orderModel;
-    OrderItemModel orderItemModel;
-    std::optional<Order> optOrder = model.getPendingOrderByUserId(user_id); // Check if there is an existing pending order for the user
-
-    if (optOrder.has_value()) // If the order exists, update it
-    {
-        Order &existingOrder = optOrder.value();
-
-        auto [updatedOrder, error] = orderModel.updateOrder(
-            user_id,
-            existingOrder.id,
-            shipping_address_id,
-            billing_address_id,
-            products,
-            shipment_date,
-            delivery_date,
-            carrier_id,
-            tracking_url,
-            tracking_number,
-            payment_method,
-            payment_status);
-
-        std::optional<int> optOrderItemId = orderItemModel.syncOrderItems(products, existingOrder.id); // Sync products with the order
-
-        web::json::value respBody;
-        if (error == Errors::NoError || error == Errors::NoRowsAffected)
-        {
-            response.set_status_code(web::http::status_codes::OK);
-            respBody[U("order_id")] = web::json::value::number(updatedOrder.value().id);
-
-            if (error == Errors::NoRowsAffected)
-            {
-                respBody[U("message")] = web::json::value::string(U("No changes made to the order"));
-            }
-            else
-            {
-                respBody[U("message")] = web::json::value::string(U("Order updated successfully"));
-            }
-
-            response.headers().add(U("Content-Type"), U("application/json"));
-            response.set_body(respBody);
-            return response;
-        }
-        else
-        {
-
-            response.set_status_code(web::http::status_codes::InternalError);
-            response.set_body(U("Error updating order"));
-            return response;
-        }
+    // 6. Create or update the pending order in a single transaction
+    Order header;
+    header.user_id = user_id;
+    header.shipping_address_id = shipping_address_id;
+    header.billing_address_id = billing_address_id;
+    header.shipment_date = shipment_date;
+    header.delivery_date = delivery_date;
+    header.carrier_id = carrier_id;
+    header.tracking_url = tracking_url;
+    header.tracking_number = tracking_number;
+    header.payment_method = payment_method;
+    header.payment_status = payment_status;
+
+    bool created = false;
+    auto [optOrder, error] = model.upsertPendingOrder(header, products, created);
+    if (!optOrder.has_value())
+    {
+        bool badRequest = error == Errors::InvalidArgument || error == Errors::NoRowsFound;
+        response.set_status_code(badRequest ? web::http::status_codes::BadRequest : web::http::status_codes::InternalError);
+        response.set_body(badRequest ? U("Invalid order data") : U("Error saving order"));
+        return response;
     }
 
-    else
-    {
-        std::cout << "carrier_id" << carrier_id << std::endl;
-        // Order does not exist, create a new order
-        std::optional<int> optOrderId = model.createOrder(
-            user_id,
-            shipping_address_id,
-            billing_address_id,
-            products,
-            shipment_date,
-            delivery_date,
-            carrier_id,
-            tracking_url,
-            tracking_number,
-            payment_method,
-            payment_status);
-
-        if (!optOrderId)
-        {
-            response.set_status_code(web::http::status_codes::InternalError);
-            response.set_body(U("Failure creating order"));
-            return response;
-        }
-
-        web::json::value respBody;
-        respBody[U("order_id")] = web::json::value::number(optOrderId.value());
-        respBody[U("message")] = web::json::value::string(U("Order created successfully"));
+    web::json::value respBody;
+    respBody[U("order_id")] = web::json::value::number(optOrder->id);
+    respBody[U("total")] = web::json::value::number(optOrder->total.toDouble());
+    respBody[U("message")] = web::json::value::string(created ? U("Order created successfully") : U("Order updated successfully"));
 
-        response.set_status_code(web::http::status_codes::Created);
-        response.headers().add(U("Content-Type"), U("application/json"));
-        response.set_body(respBody);
-        return response;
-    }
+    response.set_status_code(created ? web::http::status_codes::Created : web::http::status_codes::OK);
+    response.headers().add(U("Content-Type"), U("application/json"));
+    response.set_body(respBody);
+    return response;
 }
 
 web::http::http_response OrderController::getOrdersByUserId(const web::http::http_request &request, const int user_id)
@@ -182,7 +154,7 @@ web::http::http_response OrderController::getOrdersByUserId(const web::http::htt
             json_orders[U("shipping_address_id")] = web::json::value::number(order.shipping_address_id);
             json_orders[U("billing_address_id")] = web::json::value::number(order.billing_address_id);
             json_orders[U("status")] = web::json::value::string(order.status);
-            json_orders[U("total")] = web::json::value::number(order.total);
+            json_orders[U("total")] = web::json::value::number(order.total.toDouble());
             json_orders[U("shipment_date")] = web::json::value::string(order.shipment_date);
             json_orders[U("delivery_date")] = web::json::value::string(order.delivery_date);
             json_orders[U("carrier_id")] = web::json::value::number(order.carrier_id);
@@ -204,32 +176,20 @@ web::http::http_response OrderController::getOrdersByUserId(const web::http::htt
     return response;
 }
 
-web::http::http_response OrderController::getOrderById(const web::http::http_request &request, const int user_id)
+web::http::http_response OrderController::getOrderById(const web::http::http_request &request, const int user_id, int order_id)
 {
     web::http::http_response response;
 
-    // 2. Get order_id from the request URI
-    auto uri = request.request_uri();
-    auto path = uri.path();
-    if (path.empty() || path.find_last_of('/') == std::string::npos)
-    {
-        response.set_status_code(web::http::status_codes::BadRequest);
-        response.set_body(U("Invalid request URI"));
-        return response;
-    }
-    // Extract the order_id from the URI
-    // Assuming the URI is like /orders/{order_id}
-    auto address_id_str = path.substr(path.find_last_of('/') + 1);
-    int order_id = std::stoi(address_id_str);
-
     // 3. Call the model to get the order by ID
     OrderModel model;
     std::cout << "order_id: en controlador getorderid " << order_id << std::endl;
-    auto optOrder = model.getOrderById(order_id, user_id); // Get the order for the specified user and order ID
-    if (!optOrder.has_value())                             // If no order is found
+    auto [optOrder, errGetOrder] = model.getOrderById(order_id, user_id);
+    if (!optOrder.has_value())
     {
-        response.set_status_code(web::http::status_codes::NotFound);
-        response.set_body(U("Order not found"));
+        // Una orden de otro usuario se responde igual que una inexistente
+        bool notFound = errGetOrder == Errors::NoRowsFound || errGetOrder == Errors::NotOwner;
+        response.set_status_code(notFound ? web::http::status_codes::NotFound : web::http::status_codes::InternalError);
+        response.set_body(notFound ? U("Order not found") : U("Failed to get order"));
         return response;
     }
 
@@ -241,7 +201,7 @@ web::http::http_response OrderController::getOrderById(const web::http::http_req
     json_order[U("shipping_address_id")] = web::json::value::number(order.shipping_address_id);
     json_order[U("billing_address_id")] = web::json::value::number(order.billing_address_id);
     json_order[U("status")] = web::json::value::string(order.status);
-    json_order[U("total")] = web::json::value::number(order.total);
+    json_order[U("total")] = web::json::value::number(order.total.toDouble());
     json_order[U("shipment_date")] = web::json::value::string(order.shipment_date);
     json_order[U("delivery_date")] = web::json::value::string(order.delivery_date);
     json_order[U("carrier_id")] = web::json::value::number(order.carrier_id);
@@ -253,86 +213,41 @@ web::http::http_response OrderController::getOrderById(const web::http::http_req
     return response;
 }
 
-web::http::http_response OrderController::updateTotalbyOrderId(const web::http::http_request &request, const int user_id)
+web::http::http_response OrderController::updateTotalbyOrderId(const web::http::http_request &request, const int user_id, int order_id, int carrier_id)
 {
     web::http::http_response response;
 
-    // 2. Get carrier_id from the request URI
-    auto uri = request.request_uri(); // Extract the URI from the request
-    auto path_segments = web::uri::split_path(uri.path());
-    if (path_segments.size() != 4 || path_segments[0] != U("order") || path_segments[2] != U("carrier"))
-    {
-        response.set_status_code(web::http::status_codes::BadRequest);
-        response.set_body(U("Invalid URI format. Expected: /order/{id}/carrier/{id}"));
-        return response;
-    }
-
-    int order_id = std::stoi(path_segments[1]);
-    int carrier_id = std::stoi(path_segments[3]);
-    std::cout << "order_id: " << order_id << std::endl;
-    std::cout << "carrier_id: " << carrier_id << std::endl;
-    // 3. Call de model to get Carrier by ID
-    CarrierModel carrierModel;
-
-    auto [optCarrier, errorsGetCarrier] = carrierModel.getCarrierById(carrier_id);
-    std::cout << "Carrier price: " << optCarrier->price << std::endl;
-    if (!optCarrier.has_value())
-    {
-        response.set_status_code(web::http::status_codes::NotFound);
-        response.set_body(U("No carriers found"));
-        return response;
-    }
-
-    // 4 Call the model to get the order by ID
+    // 3. Set the carrier and recompute the total in a single statement
     OrderModel orderModel;
-    auto optOrder = orderModel.getOrderById(order_id, user_id); // Get the order for the specified user and order ID
-    if (!optOrder.has_value())                                  // If no order is found
-    {
-        response.set_status_code(web::http::status_codes::NotFound);
-        response.set_body(U("Order not found"));
-        return response;
-    }
-
-    auto [updCarrierId, errUpdateCarrierId] = orderModel.updateCarrierId(order_id, carrier_id);
-    if (!updCarrierId)
-    {
-        response.set_status_code(web::http::status_codes::InternalError);
-        response.set_body(U("Failed to update carrier id"));
-        return response;
-    }
-
-    if (errUpdateCarrierId == Errors::NoError || errUpdateCarrierId == Errors::NoRowsAffected)
-    {
-        std::cout << "Carrier id updated successfully" << std::endl;
-    }
-
-    double newTotal = optOrder->total + optCarrier->price;
-
-    // 5 call updateOrderTotal
-    auto [result, errorsUpdateOrderTotal] = orderModel.updateOrderTotal(order_id, newTotal);
-
-    if (errorsUpdateOrderTotal == Errors::NoError)
-    {
-        std::cout << "updateOrderTotal: Order total updated successfully" << std::endl;
-    }
-    else if (errorsUpdateOrderTotal == Errors::NoRowsAffected)
+    auto [newTotal, error] = orderModel.selectCarrier(order_id, user_id, carrier_id);
+    if (!newTotal.has_value())
     {
-        std::cout << "updateOrderTotal: No rows affected" << std::endl;
-    }
-
-    if (!result)
-    {
-        response.set_status_code(web::http::status_codes::InternalError);
-        response.set_body(U("Failed to update order total"));
+        if (error == Errors::InvalidArgument)
+        {
+            response.set_status_code(web::http::status_codes::NotFound);
+            response.set_body(U("No carriers found"));
+        }
+        else if (error == Errors::InvalidState)
+        {
+            response.set_status_code(web::http::status_codes::Conflict);
+            response.set_body(U("Order is no longer pending"));
+        }
+        else
+        {
+            // Una orden de otro usuario se responde igual que una inexistente
+            bool notFound = error == Errors::NoRowsFound;
+            response.set_status_code(notFound ? web::http::status_codes::NotFound : web::http::status_codes::InternalError);
+            response.set_body(notFound ? U("Order not found") : U("Failed to update order total"));
+        }
         return response;
     }
 
     response.set_status_code(web::http::status_codes::OK);
 
-    // 6. Prepare the JSON response
+    // 4. Prepare the JSON response
     web::json::value json_order;
     json_order[U("order_id")] = web::json::value::number(order_id);
-    json_order[U("total")] = web::json::value::number(newTotal);
+    json_order[U("total")] = web::json::value::number(newTotal->toDouble());
     json_order[U("update: success")] = web::json::value::boolean(true);
     response.set_body(json_order);
     return response;
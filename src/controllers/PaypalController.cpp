@@ -3,201 +3,193 @@
 PaypalController::PaypalController() {}
 OrderModel orderModel;
 
-web::http::http_response PaypalController::createPayment(const web::http::http_request &request, const int user_id)
+namespace
 {
-    web::http::http_response response;
+    pplx::task<web::http::http_response> reply(web::http::status_code status, const utility::string_t &body)
+    {
+        web::http::http_response response(status);
+        response.set_body(body);
+        return pplx::task_from_result(response);
+    }
 
-    auto segments = web::uri::split_path(request.request_uri().path());
-    auto order_id_str = segments[1];
-    if (order_id_str.empty())
+    // Cierra la cadena: plazo vencido -> 504, cualquier otra excepción -> 500
+    web::http::http_response finish(pplx::task<web::http::http_response> task)
     {
-        response.set_status_code(web::http::status_codes::BadRequest);
-        response.set_body(U("Invalid order ID"));
+        web::http::http_response response;
+        try
+        {
+            response = task.get();
+        }
+        catch (const pplx::task_canceled &)
+        {
+            response.set_status_code(web::http::status_codes::GatewayTimeout);
+            response.set_body(U("PayPal request timed out"));
+        }
+        catch (const std::exception &e)
+        {
+            response.set_status_code(web::http::status_codes::InternalError);
+            response.set_body(U("Error processing payment: ") + utility::conversions::to_string_t(e.what()));
+        }
         return response;
     }
-    int order_id = std::stoi(order_id_str);
-
-    auto optOrder = orderModel.getOrderById(order_id, user_id);
+}
 
+pplx::task<web::http::http_response> PaypalController::createPayment(const web::http::http_request &request, const int user_id, int order_id)
+{
+    auto [optOrder, errGetOrder] = orderModel.getOrderById(order_id, user_id);
     if (!optOrder.has_value())
     {
-        response.set_status_code(web::http::status_codes::NotFound);
-        response.set_body(U("Order not found"));
-        return response;
+        // Una orden de otro usuario se responde igual que una inexistente
+        bool notFound = errGetOrder == Errors::NoRowsFound || errGetOrder == Errors::NotOwner;
+        return reply(notFound ? web::http::status_codes::NotFound : web::http::status_codes::InternalError,
+                     notFound ? U("Order not found") : U("Failed to get order"));
     }
     Order order = optOrder.value();
 
     if (order.status == "COMPLETED")
     {
-        response.set_status_code(web::http::status_codes::BadRequest);
-        response.set_body(U("Order already paid"));
-        return response;
+        return reply(web::http::status_codes::BadRequest, U("Order already paid"));
     }
     if (order.status == "CANCELLED")
     {
-        response.set_status_code(web::http::status_codes::BadRequest);
-        response.set_body(U("Order cancelled"));
-        return response;
+        return reply(web::http::status_codes::BadRequest, U("Order cancelled"));
     }
 
-    PaypalService paypalService;
-    const auto total = UtilsOwner::toString2Dec(order.total);
-    if (total.empty())
+    const Money total = order.total;
+    if (total <= Money())
     {
-        response.set_status_code(web::http::status_codes::BadRequest);
-        response.set_body(U("Invalid total amount"));
-        return response;
+        return reply(web::http::status_codes::BadRequest, U("Invalid total amount"));
     }
-    try
-    {
-        OrderItemModel orderItemModel;
-        // items in the cart
-        auto [items, errors] = orderItemModel.getOrderItemsByOrderId(order_id);
 
-        if (errors != Errors::NoError)
-        {
-            response.set_status_code(web::http::status_codes::NotFound);
-            response.set_body(U("Failed to get order items"));
-            return response;
-        }
+    OrderItemModel orderItemModel;
+    // items in the cart
+    auto [items, errors] = orderItemModel.getOrderItemsByOrderId(order_id);
 
-        // check if the hash of the cart has changed
-        PaymentAttempModel paymentAttemptModel;
-        auto [paymentAttemptsOpt, paymentAttemptsError] = paymentAttemptModel.getPaymentAttemptsByOrderId(order_id);
+    if (errors != Errors::NoError)
+    {
+        return reply(web::http::status_codes::NotFound, U("Failed to get order items"));
+    }
 
-        
-        std::string current_cart_hash = items.has_value() ? UtilsOwner::hashCart(order.id, order.total, items.value()) : "";
-        std::string idempotencyKey = UtilsOwner::generateUuid(); // Default to new
-        bool shouldCreateNewAttempt = true;
+    // check if the hash of the cart has changed
+    std::string current_cart_hash = items.has_value() ? UtilsOwner::hashCart(order.id, order.total, items.value()) : "";
+    std::string idempotencyKey = UtilsOwner::generateUuid(); // Default to new
+    bool shouldCreateNewAttempt = true;
 
-        if (paymentAttemptsOpt.has_value())
-        {
-            const auto &attempts = paymentAttemptsOpt.value();
+    // Solo el último intento pendiente con el mismo carrito, vía índice
+    PaymentAttempModel paymentAttemptModel;
+    auto [lastMatching, lookupError] = paymentAttemptModel.getLatestPaymentAttempt(order_id, current_cart_hash);
+    // Solo "no hay intento" crea uno nuevo; un fallo de la consulta no debe
+    // acabar en un segundo cobro con otra clave de idempotencia
+    if (lookupError != Errors::NoError && lookupError != Errors::NoRowsFound)
+    {
+        return reply(web::http::status_codes::InternalError, U("Failed to get payment attempts"));
+    }
+    if (lastMatching.has_value())
+    {
+        idempotencyKey = lastMatching->idempotency_key;
+        shouldCreateNewAttempt = false;
+    }
 
-            // Filtra sólo los intentos con el mismo hash actual
-            std::vector<std::reference_wrapper<const PaymentAttempt>> matching;
-            matching.reserve(attempts.size());
-            for (const auto &att : attempts)
+    // A partir de aquí todo son continuaciones: el worker queda libre mientras PayPal responde.
+    // El plazo solo corta la llamada a PayPal; una vez creada la orden allí,
+    // el intento y el paypal_order_id se guardan aunque el plazo haya vencido.
+    Deadline deadline(Config::get().paypalRequestDeadline);
+    PaypalService paypalService;
+    return paypalService.createPayment(total, idempotencyKey, deadline.token())
+        .then([](web::http::http_response paymentResponse)
+              {
+            return paymentResponse.extract_json().then([paymentResponse](web::json::value jsonResponse)
+                                                       { return std::make_pair(paymentResponse.status_code(), jsonResponse); }); })
+        .then([order, user_id, order_id, current_cart_hash, idempotencyKey, shouldCreateNewAttempt](std::pair<web::http::status_code, web::json::value> result)
+              {
+            auto &[statusCode, jsonResponse] = result;
+
+            std::string storedPaypalId = order.paypal_order_id;
+            std::string newPaypalId = utility::conversions::to_utf8string(
+                jsonResponse[U("orderID")].as_string());
+            std::string status = jsonResponse[U("status")].as_string();
+
+            if (shouldCreateNewAttempt)
             {
-                if (att.cart_hash == current_cart_hash )
-                {
-                    matching.push_back(std::cref(att));
-                }
+                PaymentAttempModel paymentAttemptModel;
+                auto [paymentAttempt, created] = paymentAttemptModel.createPaymentAttempt(
+                    user_id,
+                    order_id,
+                    current_cart_hash,
+                    order.total,
+                    idempotencyKey,
+                    storedPaypalId.empty() ? newPaypalId : storedPaypalId,
+                    status);
             }
 
-            if (!matching.empty())
+            web::http::http_response response;
+            web::json::value body;
+            body[U("status")] = web::json::value::string(U("success"));
+            body[U("paypalResponse")] = jsonResponse;
+            response.set_body(body);
+            response.set_status_code(statusCode);
+
+            if (storedPaypalId != newPaypalId)
             {
-                // Elige el más reciente de los que coinciden
-                const auto &lastMatching = matching.back().get();
-                idempotencyKey = lastMatching.idempotency_key;
-                shouldCreateNewAttempt = false;
+                orderModel.updateOrderPaypalId(user_id, order_id, newPaypalId);
             }
-        }
-
-        auto paymentResponse = paypalService.createPayment(total, idempotencyKey);
-        auto jsonResponse = paymentResponse.extract_json().get();
-
-        std::string storedPaypalId = order.paypal_order_id;
-        std::string newPaypalId = utility::conversions::to_utf8string(
-            jsonResponse[U("orderID")].as_string());
-        std::string status = jsonResponse[U("status")].as_string();
-
-        if (shouldCreateNewAttempt)
-        {
-
-            auto [paymentAttempt, created] = paymentAttemptModel.createPaymentAttempt(
-                user_id,
-                order_id,
-                current_cart_hash,
-                order.total,
-                idempotencyKey,
-                storedPaypalId.empty() ? newPaypalId : storedPaypalId,
-                status);
-        }
-
-        web::json::value body;
-        body[U("status")] = web::json::value::string(U("success"));
-        body[U("paypalResponse")] = jsonResponse;
-        response.set_body(body);
-        response.set_status_code(paymentResponse.status_code());
-
-        auto orderID = jsonResponse[U("orderID")].as_string();
-        if (storedPaypalId != newPaypalId)
-        {
-            orderModel.updateOrderPaypalId(user_id, order_id, newPaypalId);
-        }
-    }
-    catch (const std::exception &e)
-    {
-        response.set_status_code(web::http::status_codes::InternalError);
-        response.set_body(U("Error processing payment: ") + utility::conversions::to_string_t(e.what()));
-    }
-    return response;
+            return response; })
+        .then(finish);
 }
 
-web::http::http_response PaypalController::capturePayment(const web::http::http_request &request, const int user_id)
+pplx::task<web::http::http_response> PaypalController::capturePayment(const web::http::http_request &request, const int user_id, utility::string_t order_id_paypal, int order_id)
 {
-
-    web::http::http_response response;
-
-    auto segments = web::uri::split_path(request.request_uri().path());
-    auto order_id_paypal = segments[1];
-    auto order_id_segment = segments[3];
-
-    if (order_id_paypal.empty() || order_id_segment.empty())
+    if (order_id_paypal.empty())
     {
-        response.set_status_code(web::http::status_codes::BadRequest);
-        response.set_body(U("Invalid order ID"));
-        return response;
+        return reply(web::http::status_codes::BadRequest, U("Invalid order ID"));
     }
-    int order_id = std::stoi(order_id_segment);
-
-
-    auto optOrder = orderModel.getOrderById(order_id, user_id);
 
+    auto [optOrder, errGetOrder] = orderModel.getOrderById(order_id, user_id);
     if (!optOrder.has_value())
     {
-        response.set_status_code(web::http::status_codes::NotFound);
-        response.set_body(U("Order not found"));
-        return response;
+        // Una orden de otro usuario se responde igual que una inexistente
+        bool notFound = errGetOrder == Errors::NoRowsFound || errGetOrder == Errors::NotOwner;
+        return reply(notFound ? web::http::status_codes::NotFound : web::http::status_codes::InternalError,
+                     notFound ? U("Order not found") : U("Failed to get order"));
     }
 
+    // Solo la llamada a PayPal está sujeta al plazo: si el cobro se ha hecho,
+    // el pedido tiene que quedar COMPLETED aunque el plazo ya haya vencido
+    Deadline deadline(Config::get().paypalRequestDeadline);
     PaypalService paypalService;
-    PaymentAttempModel paymentAttemptModel;
-    try
-    {
-        auto captureResponse = paypalService.capturePayment(order_id_paypal);
-        if (captureResponse.status_code() == web::http::status_codes::Created || captureResponse.status_code() == web::http::status_codes::OK)
-        {
-            auto [orderStatusUpdated, errUpdateOrderStatus] = orderModel.updateOrderStatus(user_id, order_id, "COMPLETED");
-            if (errUpdateOrderStatus == Errors::NoError)
-            {
-                std::cout << "orderStatusUpdated: success" << std::endl;
-            }
-            else if (errUpdateOrderStatus == Errors::NoRowsAffected)
+    return paypalService.capturePayment(order_id_paypal, deadline.token())
+        .then([user_id, order_id, order_id_paypal](web::http::http_response captureResponse)
+              {
+            if (captureResponse.status_code() == web::http::status_codes::Created || captureResponse.status_code() == web::http::status_codes::OK)
             {
-                std::cout << "orderStatusUpdated: no rows affected" << std::endl;
-            }
+                auto [orderStatusUpdated, errUpdateOrderStatus] = orderModel.updateOrderStatus(user_id, order_id, "COMPLETED");
+                if (errUpdateOrderStatus == Errors::NoError)
+                {
+                    std::cout << "orderStatusUpdated: success" << std::endl;
+                }
+                else if (errUpdateOrderStatus == Errors::NoRowsAffected)
+                {
+                    std::cout << "orderStatusUpdated: no rows affected" << std::endl;
+                }
 
-            auto [paymentAttempStatusUpdated, errUpdatePaymentAttemptStatus] = paymentAttemptModel.updatePaymentAttemptStatus(order_id_paypal, order_id, user_id, "COMPLETED");
+                PaymentAttempModel paymentAttemptModel;
+                std::string paypalOrderId = order_id_paypal;
+                auto [paymentAttempStatusUpdated, errUpdatePaymentAttemptStatus] = paymentAttemptModel.updatePaymentAttemptStatus(paypalOrderId, order_id, user_id, "COMPLETED");
 
-            if (errUpdatePaymentAttemptStatus == Errors::NoError)
-            {
-                std::cout << "paymentAttempStatusUpdated: success" << std::endl;
-            }
-            else if (errUpdatePaymentAttemptStatus == Errors::NoRowsAffected)
-            {
-                std::cout << "paymentAttempStatusUpdated: no rows affected" << std::endl;
+                if (errUpdatePaymentAttemptStatus == Errors::NoError)
+                {
+                    std::cout << "paymentAttempStatusUpdated: success" << std::endl;
+                }
+                else if (errUpdatePaymentAttemptStatus == Errors::NoRowsAffected)
+                {
+                    std::cout << "paymentAttempStatusUpdated: no rows affected" << std::endl;
+                }
             }
-        }
-        response.set_status_code(captureResponse.status_code());
-        response.set_body(captureResponse.extract_json().get());
-    }
-    catch (const std::exception &e)
-    {
-        response.set_status_code(web::http::status_codes::InternalError);
-        response.set_body(U("Error processing payment: ") + utility::conversions::to_string_t(e.what()));
-    }
-
-    return response;
-}
\ No newline at end of file
+            return captureResponse.extract_json().then([captureResponse](web::json::value body)
+                                                       {
+                web::http::http_response response;
+                response.set_status_code(captureResponse.status_code());
+                response.set_body(body);
+                return response; }); })
+        .then(finish);
+}
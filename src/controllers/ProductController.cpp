@@ -4,18 +4,16 @@
 using namespace web;
 using namespace web::http;
 
-ProductController::ProductController() : model() {} // Inicializamos el modelo en el constructor
+ProductController::ProductController() {}
 
 http_response ProductController::getAllProducts()
 {
     http_response response;
     try
     {
-        // Call model.getAllProducts(), que ahora usa el Singleton internamente
-        auto products_opt = model.getAllProducts();
-
-        // El resto de tu lógica para manejar la respuesta permanece igual
-        if (!products_opt.has_value())
+        // El catálogo se sirve desde la caché en memoria, sin tocar la base de datos
+        auto catalog = ProductCatalogCache::getInstance().get();
+        if (!catalog)
         {
             response.set_status_code(status_codes::InternalError);
             response.set_body(json::value::object({{U("message"), json::value::string(U("Error al obtener productos"))}}));
@@ -23,34 +21,8 @@ http_response ProductController::getAllProducts()
         }
         else
         {
-            const auto &products = products_opt.value();
-            std::cout << "Productos obtenidos: " << products.size() << std::endl;
-
-            if (products.empty())
-            {
-                response.set_status_code(status_codes::OK);
-                response.set_body(json::value::array());
-                std::cout << "Sin productos, devolviendo 200 con array vacío" << std::endl;
-            }
-            else
-            {
-                json::value result = json::value::array();
-                for (size_t i = 0; i < products.size(); ++i)
-                {
-                    const auto &product = products[i];
-                    json::value jsonProduct;
-                    jsonProduct[U("id")] = json::value::number(product.id);
-                    jsonProduct[U("sku")] = json::value::string(utility::conversions::to_string_t(product.sku));
-                    jsonProduct[U("name")] = json::value::string(utility::conversions::to_string_t(product.name));
-                    jsonProduct[U("description")] = json::value::string(utility::conversions::to_string_t(product.description));
-                    jsonProduct[U("price")] = json::value::number(product.price);
-                    jsonProduct[U("image_url")] = json::value::string(utility::conversions::to_string_t(product.image_url));
-                    jsonProduct[U("category_id")] = json::value::number(product.category_id);
-                    result[i] = jsonProduct;
-                }
-                response.set_status_code(status_codes::OK);
-                response.set_body(result);
-            }
+            response.set_status_code(status_codes::OK);
+            response.set_body(catalog->body, U("application/json"));
         }
     }
     catch (const std::exception &e)
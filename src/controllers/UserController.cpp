@@ -50,4 +50,14 @@ std::optional<User> UserController::getUserByEmail(const std::string &email)
         std::cout << "Email " << email << " no encontrado." << std::endl;
     }
     return userOpt;
-}
\ No newline at end of file
+}
+
+bool UserController::updatePassword(int user_id, const std::string &password)
+{
+    bool updated = model.updatePassword(user_id, password);
+    if (!updated)
+    {
+        std::cerr << "No se pudo actualizar la contraseña del usuario " << user_id << std::endl;
+    }
+    return updated;
+}
@@ -0,0 +1,226 @@
+#include "db/ConnectionPool.h"
+#include <algorithm>
+#include <iostream>
+#include "env/Config.h"
+
+namespace
+{
+    // Conexión prestada al hilo actual; los acquire() anidados la reutilizan
+    thread_local DatabaseConnection *tlsConnection = nullptr;
+}
+
+//---------- POOLED CONNECTION ----------
+
+PooledConnection::PooledConnection(ConnectionPool *pool, std::unique_ptr<DatabaseConnection> owned)
+    : pool_(pool), owned_(std::move(owned)), connection_(owned_.get()) {}
+
+PooledConnection::PooledConnection(ConnectionPool *pool, DatabaseConnection *shared)
+    : pool_(pool), connection_(shared) {}
+
+PooledConnection::~PooledConnection()
+{
+    release();
+}
+
+PooledConnection::PooledConnection(PooledConnection &&other) noexcept
+    : pool_(other.pool_), owned_(std::move(other.owned_)), connection_(other.connection_)
+{
+    other.pool_ = nullptr;
+    other.connection_ = nullptr;
+}
+
+PooledConnection &PooledConnection::operator=(PooledConnection &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        pool_ = other.pool_;
+        owned_ = std::move(other.owned_);
+        connection_ = other.connection_;
+        other.pool_ = nullptr;
+        other.connection_ = nullptr;
+    }
+    return *this;
+}
+
+void PooledConnection::release()
+{
+    if (owned_)
+    {
+        if (tlsConnection == owned_.get())
+            tlsConnection = nullptr;
+        pool_->release(std::move(owned_));
+    }
+    pool_ = nullptr;
+    connection_ = nullptr;
+}
+
+//---------- CONNECTION POOL ----------
+
+ConnectionPool &ConnectionPool::getInstance()
+{
+    static ConnectionPool instance = []()
+    {
+        const Config &config = Config::get();
+
+        DatabaseSettings database;
+        database.host = config.dbHost;
+        database.user = config.dbUser;
+        database.password = config.dbPassword;
+        database.dbname = config.dbName;
+        database.port = config.dbPort;
+
+        Settings settings;
+        settings.maxSize = config.dbPoolMax;
+        settings.minSize = config.dbPoolMin;
+        settings.acquireTimeout = config.dbPoolAcquireTimeout;
+        settings.validateAfterIdle = config.dbPoolValidateIdle;
+
+        return ConnectionPool(std::move(database), settings);
+    }();
+    return instance;
+}
+
+ConnectionPool::ConnectionPool(DatabaseSettings database, Settings settings)
+    : database_(std::move(database)), settings_(settings)
+{
+    // Precalentamos las conexiones mínimas; si MySQL no responde se abrirán bajo demanda
+    for (size_t i = 0; i < settings_.minSize; ++i)
+    {
+        auto connection = openConnection();
+        if (!connection)
+            break;
+        idle_.push_back(std::move(connection));
+        ++stats_.total;
+    }
+}
+
+std::unique_ptr<DatabaseConnection> ConnectionPool::openConnection()
+{
+    auto connection = std::make_unique<DatabaseConnection>(database_);
+    if (!connection->connect())
+        return nullptr;
+    return connection;
+}
+
+std::unique_ptr<DatabaseConnection> ConnectionPool::takeIdle(std::unique_lock<std::mutex> &lock)
+{
+    // LIFO: la conexión usada más recientemente es la que menos necesita validación
+    auto connection = std::move(idle_.back());
+    idle_.pop_back();
+
+    if (std::chrono::steady_clock::now() - connection->lastUsed() < settings_.validateAfterIdle)
+        return connection;
+
+    lock.unlock();
+    bool healthy = connection->ping() || connection->connect();
+    lock.lock();
+
+    if (!healthy)
+    {
+        std::cerr << "[DB] Conexión inactiva descartada del pool." << std::endl;
+        --stats_.total;
+        ++stats_.discarded;
+        return nullptr;
+    }
+    return connection;
+}
+
+PooledConnection ConnectionPool::acquire()
+{
+    if (tlsConnection)
+        return PooledConnection(this, tlsConnection);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + settings_.acquireTimeout;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_ptr<DatabaseConnection> connection;
+    while (!connection)
+    {
+        if (!idle_.empty())
+        {
+            connection = takeIdle(lock);
+            continue;
+        }
+
+        if (stats_.total < settings_.maxSize)
+        {
+            ++stats_.total;
+            lock.unlock();
+            connection = openConnection();
+            lock.lock();
+            if (!connection)
+            {
+                --stats_.total;
+                available_.notify_one();
+                std::cerr << "[DB] No se pudo abrir una nueva conexión." << std::endl;
+                return PooledConnection();
+            }
+            break;
+        }
+
+        ++stats_.waiting;
+        bool ready = available_.wait_until(lock, deadline, [this]()
+                                           { return !idle_.empty() || stats_.total < settings_.maxSize; });
+        --stats_.waiting;
+        if (!ready)
+        {
+            ++stats_.timeouts;
+            std::cerr << "[DB] Timeout esperando una conexión del pool (" << stats_.leased << " en uso)." << std::endl;
+            return PooledConnection();
+        }
+    }
+
+    auto waited = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    ++stats_.acquired;
+    ++stats_.leased;
+    stats_.totalWait += waited;
+    stats_.maxWait = std::max(stats_.maxWait, waited);
+    lock.unlock();
+
+    tlsConnection = connection.get();
+    return PooledConnection(this, std::move(connection));
+}
+
+void ConnectionPool::release(std::unique_ptr<DatabaseConnection> connection)
+{
+    // Un modelo que salió por error sin ROLLBACK no debe dejar la transacción a la siguiente request
+    if (connection->inTransaction())
+    {
+        std::cerr << "[DB] Conexión devuelta con transacción abierta, haciendo rollback." << std::endl;
+        mysql_rollback(connection->getConnection());
+    }
+
+    bool broken = connection->isBroken();
+    if (broken)
+        connection.reset();
+    else
+        connection->touch();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --stats_.leased;
+        if (broken)
+        {
+            --stats_.total;
+            ++stats_.discarded;
+        }
+        else
+        {
+            idle_.push_back(std::move(connection));
+        }
+    }
+    available_.notify_one();
+}
+
+ConnectionPool::Stats ConnectionPool::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats snapshot = stats_;
+    snapshot.idle = idle_.size();
+    auto statements = StatementCache::totals();
+    snapshot.statementHits = statements.hits;
+    snapshot.statementMisses = statements.misses;
+    return snapshot;
+}
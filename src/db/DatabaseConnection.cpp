@@ -1,29 +1,10 @@
 #include "db/DatabaseConnection.h"
 #include <iostream>
-#include <stdexcept>
-#include "env/EnvLoader.h"
+#include <mysql/errmsg.h>
 
-DatabaseConnection::DatabaseConnection() : connection(nullptr)
+DatabaseConnection::DatabaseConnection(const DatabaseSettings &settings)
+    : connection(nullptr), settings_(settings), lastUsed_(std::chrono::steady_clock::now())
 {
-    EnvLoader env(".env");
-    env.load();
-
-    host = env.get("DB_HOST", "localhost");
-    user = env.get("DB_USER", "root");
-    password = env.get("DB_PASSWORD", "");
-    dbname = env.get("DB_NAME", "tienda_del_alma");
-
-    try
-    {
-        port = static_cast<unsigned int>(std::stoi(env.get("DB_PORT", "3306")));
-    }
-    catch (...)
-    {
-        std::cerr << "Error al leer el puerto. Usando 3306." << std::endl;
-        port = 3306;
-    }
-
-    connect();
 }
 
 DatabaseConnection::~DatabaseConnection()
@@ -31,16 +12,11 @@ DatabaseConnection::~DatabaseConnection()
     close();
 }
 
-DatabaseConnection &DatabaseConnection::getInstance()
-{
-    thread_local static DatabaseConnection instance;
-    return instance;
-}
-
 bool DatabaseConnection::connect()
 {
     if (connection)
     {
+        statements_.clear();
         mysql_close(connection);
         connection = nullptr;
     }
@@ -52,7 +28,8 @@ bool DatabaseConnection::connect()
         return false;
     }
 
-    if (!mysql_real_connect(connection, host.c_str(), user.c_str(), password.c_str(), dbname.c_str(), port, nullptr, 0))
+    if (!mysql_real_connect(connection, settings_.host.c_str(), settings_.user.c_str(), settings_.password.c_str(),
+                            settings_.dbname.c_str(), settings_.port, nullptr, 0))
     {
         std::cerr << "mysql_real_connect falló: " << mysql_error(connection) << std::endl;
         mysql_close(connection);
@@ -60,28 +37,33 @@ bool DatabaseConnection::connect()
         return false;
     }
 
+    touch();
     return true;
 }
 
-MYSQL *DatabaseConnection::getConnection()
+bool DatabaseConnection::ping()
 {
-    if (!connection || mysql_ping(connection) != 0)
-    {
-        std::cerr << "[DB] Conexión inactiva, reconectando..." << std::endl;
-        if (!connect())
-        {
-            std::cerr << "[DB] Error al reconectar." << std::endl;
-            return nullptr;
-        }
-    }
+    return connection && mysql_ping(connection) == 0;
+}
 
-    return connection;
+bool DatabaseConnection::isBroken() const
+{
+    if (!connection)
+        return true;
+    unsigned int err = mysql_errno(connection);
+    return err == CR_SERVER_GONE_ERROR || err == CR_SERVER_LOST;
+}
+
+bool DatabaseConnection::inTransaction() const
+{
+    return connection && (connection->server_status & SERVER_STATUS_IN_TRANS);
 }
 
 void DatabaseConnection::close()
 {
     if (connection)
     {
+        statements_.clear();
         mysql_close(connection);
         connection = nullptr;
         std::cout << "[DB] Conexión cerrada." << std::endl;
@@ -3,7 +3,7 @@
 
 bool DatabaseInitializer::executeQuery(const std::string &query)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -24,7 +24,7 @@ bool DatabaseInitializer::executeQuery(const std::string &query)
 
 bool DatabaseInitializer::initialize(bool forceInit)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -195,6 +195,8 @@ bool DatabaseInitializer::initialize(bool forceInit)
             "paypal_order_id VARCHAR(100), "
             "observations TEXT, "
             "order_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP, "
+            "INDEX idx_orders_user_id (user_id, id), "
+            "INDEX idx_orders_user_status (user_id, status), "
             "FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE, "
             "FOREIGN KEY (billing_address_id) REFERENCES billing_addresses(id) ON DELETE CASCADE, "
             "FOREIGN KEY (shipping_address_id) REFERENCES shipping_addresses(id) ON DELETE CASCADE, "
@@ -215,7 +217,9 @@ bool DatabaseInitializer::initialize(bool forceInit)
             "status VARCHAR(50), "
             "created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP, "
             "FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE, "
-            "UNIQUE KEY unique_attempt (user_id, cart_hash)"
+            "UNIQUE KEY unique_attempt (user_id, cart_hash), "
+            // Índice que cubre la búsqueda de createPayment (el id va implícito en InnoDB)
+            "INDEX idx_payment_attempts_lookup (order_id, cart_hash, status, idempotency_key, paypal_order_id)"
             ") ENGINE=InnoDB;";
     if (!executeQuery(query))
         return false;
@@ -227,6 +231,7 @@ bool DatabaseInitializer::initialize(bool forceInit)
             "product_id INT NOT NULL, "
             "quantity INT NOT NULL CHECK (quantity > 0), "
             "price DECIMAL(10,2) NOT NULL, "
+            "UNIQUE KEY uq_order_items_order_product (order_id, product_id), "
             "FOREIGN KEY (order_id) REFERENCES orders(id) ON DELETE CASCADE, "
             "FOREIGN KEY (product_id) REFERENCES products(id)"
             ") ENGINE=InnoDB;";
@@ -0,0 +1,115 @@
+#include "db/StatementCache.h"
+#include <iostream>
+
+std::atomic<uint64_t> StatementCache::totalHits_{0};
+std::atomic<uint64_t> StatementCache::totalMisses_{0};
+
+//---------- CACHED STATEMENT ----------
+
+CachedStatement::~CachedStatement()
+{
+    release();
+}
+
+CachedStatement::CachedStatement(CachedStatement &&other) noexcept
+    : stmt_(other.stmt_), entry_(other.entry_), error_(std::move(other.error_))
+{
+    other.stmt_ = nullptr;
+    other.entry_ = nullptr;
+}
+
+CachedStatement &CachedStatement::operator=(CachedStatement &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        stmt_ = other.stmt_;
+        entry_ = other.entry_;
+        error_ = std::move(other.error_);
+        other.stmt_ = nullptr;
+        other.entry_ = nullptr;
+    }
+    return *this;
+}
+
+void CachedStatement::release()
+{
+    if (!stmt_)
+        return;
+
+    if (entry_)
+    {
+        // Descarta filas sin leer para que el siguiente uso empiece limpio
+        mysql_stmt_free_result(stmt_);
+        entry_->inUse = false;
+    }
+    else
+    {
+        mysql_stmt_close(stmt_);
+    }
+    stmt_ = nullptr;
+    entry_ = nullptr;
+}
+
+//---------- STATEMENT CACHE ----------
+
+StatementCache::StatementCache(size_t capacity) : capacity_(capacity) {}
+
+StatementCache::~StatementCache()
+{
+    clear();
+}
+
+CachedStatement StatementCache::prepare(MYSQL *conn, std::string_view sql)
+{
+    auto it = entries_.find(sql);
+    if (it != entries_.end() && !it->second.inUse)
+    {
+        ++hits_;
+        totalHits_.fetch_add(1, std::memory_order_relaxed);
+        it->second.inUse = true;
+        return CachedStatement(it->second.stmt, &it->second);
+    }
+
+    ++misses_;
+    totalMisses_.fetch_add(1, std::memory_order_relaxed);
+
+    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    if (!stmt)
+        return CachedStatement(std::string("Statement initialization failed: ") + mysql_error(conn));
+
+    if (mysql_stmt_prepare(stmt, sql.data(), sql.size()) != 0)
+    {
+        std::string error = mysql_stmt_error(stmt);
+        mysql_stmt_close(stmt);
+        return CachedStatement(std::move(error));
+    }
+
+    // La misma SQL ya prestada (llamada anidada) o caché llena: sentencia de un solo uso
+    if (it != entries_.end() || entries_.size() >= capacity_)
+        return CachedStatement(stmt, nullptr);
+
+    auto [inserted, ok] = entries_.emplace(std::string(sql), StatementEntry{stmt, true});
+    return CachedStatement(stmt, &inserted->second);
+}
+
+void StatementCache::clear()
+{
+    for (auto &[sql, entry] : entries_)
+    {
+        if (entry.inUse)
+            std::cerr << "[DB] Cerrando sentencia en uso: " << sql << std::endl;
+        mysql_stmt_close(entry.stmt);
+    }
+    entries_.clear();
+}
+
+StatementCache::Stats StatementCache::stats() const
+{
+    return {hits_, misses_, entries_.size()};
+}
+
+StatementCache::Stats StatementCache::totals()
+{
+    return {totalHits_.load(std::memory_order_relaxed), totalMisses_.load(std::memory_order_relaxed), 0};
+}
@@ -0,0 +1,150 @@
+#include "env/Config.h"
+#include "env/EnvLoader.h"
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Los snapshots publicados no se liberan nunca: las recargas son raras y
+    // así cualquier referencia obtenida con Config::get() sigue siendo válida.
+    std::mutex publishMutex;
+    std::vector<std::unique_ptr<const Config>> snapshots;
+    std::atomic<const Config *> current{nullptr};
+
+    void publishLocked(Config config)
+    {
+        snapshots.push_back(std::make_unique<const Config>(std::move(config)));
+        current.store(snapshots.back().get(), std::memory_order_release);
+    }
+
+    // Variables del proceso primero, luego el fichero .env
+    class Source
+    {
+    public:
+        explicit Source(const std::string &filename) : file_(filename) { file_.load(); }
+
+        std::string get(const std::string &key, const std::string &fallback) const
+        {
+            if (const char *value = std::getenv(key.c_str()))
+                return value;
+            return file_.get(key, fallback);
+        }
+
+        long long getNumber(const std::string &key, long long fallback) const
+        {
+            try
+            {
+                long long value = std::stoll(get(key, std::to_string(fallback)));
+                return value >= 0 ? value : fallback;
+            }
+            catch (...)
+            {
+                std::cerr << "Error al leer " << key << ". Usando " << fallback << "." << std::endl;
+                return fallback;
+            }
+        }
+
+    private:
+        EnvLoader file_;
+    };
+}
+
+Config Config::load(const std::string &filename)
+{
+    Source env(filename);
+    Config config;
+
+    config.dbHost = env.get("DB_HOST", config.dbHost);
+    config.dbUser = env.get("DB_USER", config.dbUser);
+    config.dbPassword = env.get("DB_PASSWORD", config.dbPassword);
+    config.dbName = env.get("DB_NAME", config.dbName);
+    config.dbPort = static_cast<unsigned int>(env.getNumber("DB_PORT", config.dbPort));
+    config.dbPoolMax = std::max<size_t>(1, env.getNumber("DB_POOL_MAX", config.dbPoolMax));
+    config.dbPoolMin = std::min<size_t>(env.getNumber("DB_POOL_MIN", config.dbPoolMin), config.dbPoolMax);
+    config.dbPoolAcquireTimeout = std::chrono::milliseconds(env.getNumber("DB_POOL_ACQUIRE_TIMEOUT_MS", config.dbPoolAcquireTimeout.count()));
+    config.dbPoolValidateIdle = std::chrono::milliseconds(env.getNumber("DB_POOL_VALIDATE_IDLE_MS", config.dbPoolValidateIdle.count()));
+
+    config.serverAddress = env.get("SERVER_ADDRESS", config.serverAddress);
+
+    config.productsCacheTtl = std::chrono::seconds(env.getNumber("PRODUCTS_CACHE_TTL_SECONDS", config.productsCacheTtl.count()));
+    config.referenceCacheTtl = std::chrono::seconds(env.getNumber("REFERENCE_CACHE_TTL_SECONDS", config.referenceCacheTtl.count()));
+    config.authTokenCacheSize = env.getNumber("AUTH_TOKEN_CACHE_SIZE", config.authTokenCacheSize);
+    config.authTokenCacheMaxTtl = std::chrono::seconds(env.getNumber("AUTH_TOKEN_CACHE_MAX_TTL_SECONDS", config.authTokenCacheMaxTtl.count()));
+
+    config.jwtSecret = env.get("JWT_SECRET", config.jwtSecret);
+    config.googleClientId = env.get("GOOGLE_CLIENT_ID", config.googleClientId);
+    config.auth0Issuer = env.get("AUTH0_ISSUER", config.auth0Issuer);
+    config.auth0PublicKeyPath = env.get("AUTH0_PUBLIC_KEY_PATH", config.auth0PublicKeyPath);
+    config.auth0JwksPath = env.get("AUTH0_JWKS_PATH", config.auth0JwksPath);
+    config.auth0KeysReload = std::chrono::seconds(env.getNumber("AUTH0_KEYS_RELOAD_SECONDS", config.auth0KeysReload.count()));
+
+    config.passwordHashWorkers = std::max<size_t>(1, env.getNumber("PASSWORD_HASH_WORKERS", config.passwordHashWorkers));
+    config.passwordHashQueueMax = env.getNumber("PASSWORD_HASH_QUEUE_MAX", config.passwordHashQueueMax);
+    config.passwordHashMemoryBudgetMb = env.getNumber("PASSWORD_HASH_MEMORY_BUDGET_MB", config.passwordHashMemoryBudgetMb);
+    config.passwordHashRetryAfter = std::chrono::seconds(env.getNumber("PASSWORD_HASH_RETRY_AFTER_SECONDS", config.passwordHashRetryAfter.count()));
+    config.passwordHashProfile = env.get("PASSWORD_HASH_PROFILE", config.passwordHashProfile);
+    config.passwordHashOpsLimit = env.getNumber("PASSWORD_HASH_OPSLIMIT", config.passwordHashOpsLimit);
+    config.passwordHashMemLimitMb = env.getNumber("PASSWORD_HASH_MEMLIMIT_MB", config.passwordHashMemLimitMb);
+    config.passwordHashTargetVerify = std::chrono::milliseconds(env.getNumber("PASSWORD_HASH_TARGET_MS", config.passwordHashTargetVerify.count()));
+
+    config.paypalClientId = env.get("PAYPAL_CLIENT_ID", config.paypalClientId);
+    config.paypalClientSecret = env.get("PAYPAL_CLIENT_SECRET", config.paypalClientSecret);
+    config.paypalApiBase = env.get("PAYPAL_API_BASE", config.paypalApiBase);
+    config.paypalHttpTimeout = std::chrono::seconds(env.getNumber("PAYPAL_HTTP_TIMEOUT_SECONDS", config.paypalHttpTimeout.count()));
+    config.paypalRequestDeadline = std::chrono::milliseconds(env.getNumber("PAYPAL_REQUEST_DEADLINE_MS", config.paypalRequestDeadline.count()));
+    config.paypalTokenRefreshMargin = std::chrono::seconds(env.getNumber("PAYPAL_TOKEN_REFRESH_MARGIN_SECONDS", config.paypalTokenRefreshMargin.count()));
+
+    return config;
+}
+
+const Config &Config::get()
+{
+    const Config *config = current.load(std::memory_order_acquire);
+    if (config)
+        return *config;
+
+    // Primer uso: se carga una sola vez aunque lleguen varios hilos a la vez
+    std::lock_guard<std::mutex> lock(publishMutex);
+    config = current.load(std::memory_order_acquire);
+    if (!config)
+    {
+        publishLocked(load());
+        config = current.load(std::memory_order_acquire);
+    }
+    return *config;
+}
+
+void Config::reload(const std::string &filename)
+{
+    Config config = load(filename);
+    std::lock_guard<std::mutex> lock(publishMutex);
+    publishLocked(std::move(config));
+    std::cout << "[Config] Configuración recargada" << std::endl;
+}
+
+void Config::watchReloadSignal()
+{
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGHUP);
+    // Los hilos creados después heredan la máscara, así que solo este hilo recibe SIGHUP
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    std::thread([signals]()
+                {
+        int signal = 0;
+        while (sigwait(&signals, &signal) == 0)
+        {
+            if (signal == SIGHUP)
+                Config::reload();
+        } })
+        .detach();
+}
@@ -1,7 +1,9 @@
 #include "middleware/AuthMiddleware.h"
-#include "services/jwt/Auth0JwtUtils.h"
-#include "env/EnvLoader.h"
+#include "services/jwt/Auth0KeyStore.h"
+#include "middleware/TokenCache.h"
 
+#include <atomic>
+#include <chrono>
 #include <cpprest/http_msg.h>
 #include <cpprest/json.h>
 #include <iostream>
@@ -11,73 +13,170 @@ using namespace web::http;
 
 UserController userController;
 
-std::optional<DecodedUser> AuthMiddleware::authenticateGoogleRequest(const http_request &request)
+namespace
 {
-    try
+    struct VerifierCounters
     {
-        EnvLoader env(".env");
-        env.load();
+        std::atomic<uint64_t> attempts{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> totalMicros{0};
 
-        // Obtener token desde el header Authorization: Bearer <id_token>
-        auto headers = request.headers();
-        if (!headers.has(U("Authorization")))
-        {
-            std::cerr << "Falta el header Authorization\n";
-            return std::nullopt;
-        }
-        auto authHeader = headers[U("Authorization")];
-        auto tokenStr = utility::conversions::to_utf8string(authHeader);
-        if (tokenStr.rfind("Bearer ", 0) != 0)
+        AuthMiddleware::VerifierStats snapshot() const
         {
-            std::cerr << "Formato incorrecto del Authorization header\n";
-            return std::nullopt;
+            return {attempts.load(), failures.load(), totalMicros.load()};
         }
+    };
+
+    VerifierCounters localCounters;
+    VerifierCounters auth0Counters;
+    std::atomic<uint64_t> cacheHits{0};
+    std::atomic<uint64_t> rejected{0};
 
-        std::string id_token = tokenStr.substr(7); // Quitar "Bearer "
+    const std::string kLocalIssuer = "tienda_del_alma";
 
-        // Leer clave pública del archivo
-        std::string publicKeyPem = Auth0JwtUtils::readPemFile("config/auth0_public.pem");
+    TokenType classify(const Auth0KeyStore::Decoded &decoded)
+    {
+        if (!decoded.has_algorithm())
+            return TokenType::Unknown;
+
+        const auto alg = decoded.get_algorithm();
+        if (alg == "HS256" && decoded.has_issuer() && decoded.get_issuer() == kLocalIssuer)
+            return TokenType::Local;
+        if (alg == "RS256")
+            return TokenType::Auth0;
+        return TokenType::Unknown;
+    }
+
+    // Mide la verificación y cuenta los fallos de cada verificador
+    template <typename Verify>
+    std::optional<DecodedUser> timed(VerifierCounters &counters, Verify &&verify)
+    {
+        ++counters.attempts;
+        auto start = std::chrono::steady_clock::now();
+        auto user = verify();
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        counters.totalMicros += elapsed.count();
+        if (!user.has_value())
+            ++counters.failures;
+        return user;
+    }
 
-        // Verificar y extraer los datos
-        auto decoded = Auth0JwtUtils::verifyAndExtractUser(
-            id_token,
-            publicKeyPem,
-            env.get("GOOGLE_CLIENT_ID"),
-            env.get("AUTH0_ISSUER"));
-        const auto dbUserOpt = userController.getUserByEmail(decoded.email);
-        if (!dbUserOpt.has_value())
+    std::optional<DecodedUser> verifyAuth0(const Auth0KeyStore::Decoded &decoded)
+    {
+        try
+        {
+            auto verified = Auth0KeyStore::getInstance().verifyAndExtractUser(decoded);
+            const auto dbUserOpt = userController.getUserByEmail(verified.email);
+            if (!dbUserOpt.has_value())
+            {
+                std::cerr << "Usuario no encontrado en la base de datos: " << verified.email << std::endl;
+                return std::nullopt;
+            }
+            DecodedUser enriched;
+            enriched.id = dbUserOpt.value().id; // Aquí pones el user_id real
+            enriched.email = verified.email;
+            enriched.sub = verified.sub;
+            enriched.exp = verified.exp;
+            return enriched;
+        }
+        catch (const std::exception &ex)
         {
-            std::cerr << "Usuario no encontrado en la base de datos: " << decoded.email << std::endl;
+            std::cerr << "Error autenticando token: " << ex.what() << std::endl;
             return std::nullopt;
         }
-        const auto &dbUser = dbUserOpt.value();
-        DecodedUser enriched;
-        enriched.id = dbUser.id; // Aquí pones el user_id real
-        enriched.email = decoded.email;
-        enriched.sub = decoded.sub;
+    }
+}
 
-        return enriched;
+std::optional<std::string> AuthMiddleware::getBearerToken(const http_request &request)
+{
+    auto authHeader = request.headers().find(U("Authorization"));
+    if (authHeader == request.headers().end())
+    {
+        return std::nullopt;
+    }
+    auto tokenStr = utility::conversions::to_utf8string(authHeader->second);
+    if (tokenStr.rfind("Bearer ", 0) != 0)
+    {
+        std::cerr << "Formato incorrecto del Authorization header\n";
+        return std::nullopt;
+    }
+    return tokenStr.substr(7); // Quitar "Bearer "
+}
+
+// Cada token va a un único verificador según su alg/iss
+std::optional<DecodedUser> AuthMiddleware::authenticateToken(const std::string &token)
+{
+    auto cached = TokenCache::getInstance().get(token);
+    if (cached.has_value())
+    {
+        ++cacheHits;
+        return cached;
+    }
+
+    std::optional<Auth0KeyStore::Decoded> decoded;
+    try
+    {
+        decoded.emplace(jwt::decode(token));
     }
     catch (const std::exception &ex)
     {
-        std::cerr << "Error autenticando token: " << ex.what() << std::endl;
+        ++rejected;
+        std::cerr << "Token mal formado: " << ex.what() << std::endl;
+        return std::nullopt;
+    }
+
+    std::optional<DecodedUser> user;
+    switch (classify(*decoded))
+    {
+    case TokenType::Local:
+        user = timed(localCounters, [&]()
+                     { return JwtService::verifyAndExtractUser(*decoded); });
+        break;
+    case TokenType::Auth0:
+        user = timed(auth0Counters, [&]()
+                     { return verifyAuth0(*decoded); });
+        break;
+    case TokenType::Unknown:
+        ++rejected;
+        std::cerr << "Token de tipo desconocido" << std::endl;
         return std::nullopt;
     }
+
+    if (user.has_value())
+    {
+        TokenCache::getInstance().put(token, user.value());
+    }
+    return user;
 }
 
 std::optional<DecodedUser> AuthMiddleware::authenticateRequest(const http_request &request)
 {
-    auto userOptGoogle = authenticateGoogleRequest(request);
-    if (userOptGoogle.has_value())
+    // Authorization: Bearer <token> tiene prioridad sobre la cookie de sesión
+    auto bearer = getBearerToken(request);
+    if (bearer.has_value())
     {
-        return userOptGoogle;
+        auto user = authenticateToken(bearer.value());
+        if (user.has_value())
+        {
+            return user;
+        }
     }
 
-    auto userOptLocal = AuthUtils::getUserFromRequest(request);
-    if (userOptLocal.has_value())
+    auto cookie = AuthUtils::getTokenFromRequest(request);
+    if (cookie.has_value() && cookie != bearer)
     {
-        return userOptLocal;
+        return authenticateToken(cookie.value());
     }
 
     return std::nullopt;
-}
\ No newline at end of file
+}
+
+AuthMiddleware::Stats AuthMiddleware::stats()
+{
+    Stats result;
+    result.local = localCounters.snapshot();
+    result.auth0 = auth0Counters.snapshot();
+    result.cacheHits = cacheHits.load();
+    result.rejected = rejected.load();
+    return result;
+}
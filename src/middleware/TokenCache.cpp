@@ -0,0 +1,134 @@
+#include "middleware/TokenCache.h"
+#include <iostream>
+#include <stdexcept>
+#include <openssl/evp.h>
+#include "env/Config.h"
+
+TokenCache &TokenCache::getInstance()
+{
+    static TokenCache instance = []()
+    {
+        const Config &config = Config::get();
+        return TokenCache(config.authTokenCacheSize > 0 ? config.authTokenCacheSize : 10000, config.authTokenCacheMaxTtl);
+    }();
+    return instance;
+}
+
+TokenCache::TokenCache(size_t capacity, std::chrono::seconds maxTtl)
+    : shardCapacity_(capacity / kShards + 1), maxTtl_(maxTtl) {}
+
+TokenCache::Digest TokenCache::digest(const std::string &token)
+{
+    Digest result{};
+    unsigned int length = 0;
+    if (EVP_Digest(token.data(), token.size(), result.data(), &length, EVP_sha256(), nullptr) != 1)
+        throw std::runtime_error("Failed to hash token");
+    return result;
+}
+
+std::optional<DecodedUser> TokenCache::get(const std::string &token)
+{
+    if (maxTtl_.count() <= 0)
+        return std::nullopt;
+
+    Digest key = digest(token);
+    Shard &shard = shardFor(key);
+    auto now = std::chrono::system_clock::now();
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end())
+    {
+        ++shard.misses;
+        return std::nullopt;
+    }
+
+    if (it->second->expiresAt <= now)
+    {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+        ++shard.misses;
+        return std::nullopt;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    ++shard.hits;
+    return it->second->user;
+}
+
+void TokenCache::put(const std::string &token, const DecodedUser &user)
+{
+    if (maxTtl_.count() <= 0)
+        return;
+
+    auto now = std::chrono::system_clock::now();
+    auto expiresAt = now + maxTtl_;
+    if (user.exp > 0)
+    {
+        auto tokenExpiry = std::chrono::system_clock::time_point(std::chrono::seconds(user.exp));
+        if (tokenExpiry <= now)
+            return;
+        expiresAt = std::min(expiresAt, tokenExpiry);
+    }
+
+    Digest key = digest(token);
+    Shard &shard = shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end())
+    {
+        it->second->user = user;
+        it->second->expiresAt = expiresAt;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    shard.lru.push_front(Entry{key, user, expiresAt});
+    shard.index.emplace(key, shard.lru.begin());
+
+    if (shard.lru.size() > shardCapacity_)
+    {
+        shard.index.erase(shard.lru.back().digest);
+        shard.lru.pop_back();
+        ++shard.evictions;
+    }
+}
+
+void TokenCache::erase(const std::string &token)
+{
+    Digest key = digest(token);
+    Shard &shard = shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end())
+    {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    }
+}
+
+void TokenCache::clear()
+{
+    for (auto &shard : shards_)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.lru.clear();
+        shard.index.clear();
+    }
+}
+
+TokenCache::Stats TokenCache::stats() const
+{
+    Stats total;
+    for (const auto &shard : shards_)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total.hits += shard.hits;
+        total.misses += shard.misses;
+        total.evictions += shard.evictions;
+        total.size += shard.lru.size();
+    }
+    return total;
+}
@@ -28,7 +28,7 @@ std::optional<int> AddressModel::createAddress(
     }
 
     // Obtener el puntero a la conexión MySQL
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -46,18 +46,12 @@ std::optional<int> AddressModel::createAddress(
         query = "INSERT INTO shipping_addresses (user_id, first_name, last_name, phone, street, city, province, postal_code, country, is_default, additional_info) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
     }
 
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt)
+        std::cerr << "Statement preparation failed: " << stmt_guard.error()
                   << " (MySQL error: " << mysql_error(conn) << ")" << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -193,7 +187,6 @@ std::optional<int> AddressModel::createAddress(
     {
         std::cerr << "Parameter binding failed: " << mysql_stmt_error(stmt)
                   << " (MySQL error: " << mysql_error(conn) << ")" << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -202,7 +195,6 @@ std::optional<int> AddressModel::createAddress(
     {
         std::cerr << "Execution failed: " << mysql_stmt_error(stmt)
                   << " (MySQL error: " << mysql_error(conn) << ")" << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -210,7 +202,6 @@ std::optional<int> AddressModel::createAddress(
     int address_id = mysql_insert_id(conn);
 
     std::cout << "Address created successfully for user_id: " << user_id << std::endl;
-    mysql_stmt_close(stmt);
     return address_id;
 }
 
@@ -218,11 +209,11 @@ std::optional<int> AddressModel::createAddress(
 std::optional<std::vector<Address>> AddressModel::getAllAddressByUserId(const int user_id)
 {
     std::cout << "Getting all addresses for user_id: " << user_id << std::endl;
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
+        std::cerr << "Error: No active database connection" << std::endl;
         return std::nullopt;
     }
 
@@ -234,17 +225,11 @@ std::optional<std::vector<Address>> AddressModel::getAllAddressByUserId(const in
         "SELECT id, first_name, last_name, phone, street, city, province, postal_code, country, is_default, additional_info, created_at, 'shipping' AS type "
         "FROM shipping_addresses WHERE user_id = ?";
 
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
+        std::cerr << "Statement preparation failed: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
     std::cout << "Query prepared successfully" << std::endl;
@@ -436,11 +421,11 @@ std::pair<std::optional<bool>, Errors> AddressModel::updateAddress(
     const std::string &additional_info)
 {
     // Obtener la conexión a la base de datos
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        fprintf(stderr, "Error: No active database connection: %s\n", mysql_error(conn));
+        fprintf(stderr, "Error: No active database connection\n");
         return {std::nullopt, Errors::DatabaseConnectionFailed};
     }
 
@@ -467,20 +452,11 @@ std::pair<std::optional<bool>, Errors> AddressModel::updateAddress(
             "WHERE id = ? AND user_id = ?";
     }
     // Inicializar la sentencia
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        fprintf(stderr, "Statement initialization failed: %s\n", mysql_error(conn));
-        mysql_query(conn, "ROLLBACK");
-        return {std::nullopt, Errors::StatementInitFailed};
-    }
-    // Utilizamos RAII para garantizar que se cierre el statement
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    // Preparar la sentencia SQL
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        fprintf(stderr, "Statement preparation failed: %s\n", mysql_stmt_error(stmt));
+        fprintf(stderr, "Statement preparation failed: %s\n", stmt_guard.error());
         mysql_query(conn, "ROLLBACK");
         return {std::nullopt, Errors::StatementPrepareFailed};
     }
@@ -587,11 +563,11 @@ std::pair<std::optional<bool>, Errors> AddressModel::updateAddress(
 std::optional<Address> AddressModel::getAddressById(const int &address_id, const int &user_id, const std::string &type)
 {
     // Obtener la conexión a la base de datos
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
+        std::cerr << "Error: No active database connection" << std::endl;
         return std::nullopt;
     }
 
@@ -612,18 +588,11 @@ std::optional<Address> AddressModel::getAddressById(const int &address_id, const
             "FROM shipping_addresses WHERE id = ? AND user_id = ?";
     }
     // Inicializar la sentencia
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-    // Utilizamos RAII para garantizar que se cierre el statement
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-    // Preparar la sentencia SQL
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
+        std::cerr << "Statement preparation failed: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
     // Declarar el arreglo para los parámetros. La cantidad total de parámetros en la consulta es 2
@@ -774,11 +743,11 @@ std::optional<std::string> AddressModel::deleteAddress(
     const int &address_id, const std::string &type)
 {
     // Obtener la conexión a la base de datos
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
+        std::cerr << "Error: No active database connection" << std::endl;
         return std::nullopt;
     }
 
@@ -795,19 +764,11 @@ std::optional<std::string> AddressModel::deleteAddress(
             "DELETE FROM shipping_addresses WHERE id = ? AND user_id = ?";
     }
     // Inicializar la sentencia
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-    // Utilizamos RAII para garantizar que se cierre el statement
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    // Preparar la sentencia SQL
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
+        std::cerr << "Statement preparation failed: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
 
@@ -855,11 +816,11 @@ else
 
 std::pair<std::optional<bool>, Errors> AddressModel::setDefaultAddress(const int user_id, const int address_id, std::string &type)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
+        std::cerr << "Error: No active database connection" << std::endl;
         return {false, Errors::DatabaseConnectionFailed};
     }
 
@@ -882,19 +843,11 @@ std::pair<std::optional<bool>, Errors> AddressModel::setDefaultAddress(const int
             "UPDATE shipping_addresses SET is_default = 0 WHERE user_id = ? ";
     }
 
-    MYSQL_STMT *reset_stmt = mysql_stmt_init(conn);
+    auto reset_stmt_guard = db.prepare(reset_query);
+    MYSQL_STMT *reset_stmt = reset_stmt_guard.get();
     if (!reset_stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::StatementInitFailed};
-    }
-
-    auto reset_stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(reset_stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(reset_stmt, reset_query, strlen(reset_query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(reset_stmt) << std::endl;
+        std::cerr << "Statement preparation failed: " << reset_stmt_guard.error() << std::endl;
         mysql_query(conn, "ROLLBACK");
         return {false, Errors::StatementPrepareFailed};
     }
@@ -954,19 +907,11 @@ std::pair<std::optional<bool>, Errors> AddressModel::setDefaultAddress(const int
             "UPDATE shipping_addresses SET is_default = 1 WHERE id = ? AND user_id = ?";
     }
 
-    MYSQL_STMT *set_stmt = mysql_stmt_init(conn);
-
+    auto set_stmt_guard = db.prepare(set_query);
+    MYSQL_STMT *set_stmt = set_stmt_guard.get();
     if (!set_stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::StatementInitFailed};
-    }
-    auto set_stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(set_stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(set_stmt, set_query, strlen(set_query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(set_stmt) << std::endl;
+        std::cerr << "Statement preparation failed: " << set_stmt_guard.error() << std::endl;
         mysql_query(conn, "ROLLBACK");
         return {false, Errors::StatementPrepareFailed};
     }
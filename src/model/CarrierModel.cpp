@@ -1,11 +1,13 @@
 #include "model/CarrierModel.h"
+#include "db/MoneyBind.h"
 #include <iostream>
+#include "services/ReferenceDataCache.h"
 
 CarrierModel::CarrierModel() {}
 
 bool CarrierModel::insertSampleCarriers()
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -40,12 +42,13 @@ bool CarrierModel::insertSampleCarriers()
     }
 
     std::cout << "Sample carriers inserted successfully." << std::endl;
+    ReferenceDataCache::carriers().invalidate();
     return true;
 }
 
 std::pair<std::optional<std::vector<Carrier>>, Errors> CarrierModel::getAllCarriers()
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -54,16 +57,11 @@ std::pair<std::optional<std::vector<Carrier>>, Errors> CarrierModel::getAllCarri
     }
 
     const char *query = "SELECT id, name, price FROM carriers";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Failed to initialize statement" << std::endl;
-        return {std::nullopt, Errors::StatementInitFailed};
-    }
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-    if (mysql_stmt_prepare(stmt, query, strlen(query)))
-    {
-        std::cerr << "Failed to prepare statement: " << mysql_error(conn) << std::endl;
+        std::cerr << "Failed to prepare statement: " << stmt_guard.error() << std::endl;
         return {std::nullopt, Errors::StatementPrepareFailed};
     }
 
@@ -80,7 +78,7 @@ std::pair<std::optional<std::vector<Carrier>>, Errors> CarrierModel::getAllCarri
 
     int id;
     char name[50];
-    double price;
+    MoneyBind price;
     bool is_null[3];
     unsigned long length[3];
 
@@ -95,10 +93,7 @@ std::pair<std::optional<std::vector<Carrier>>, Errors> CarrierModel::getAllCarri
     result_bind[1].is_null = &is_null[1];
     result_bind[1].length = &length[1];
 
-    result_bind[2].buffer_type = MYSQL_TYPE_DOUBLE;
-    result_bind[2].buffer = &price;
-    result_bind[2].is_null = &is_null[2];
-    result_bind[2].length = &length[2];
+    price.bindResult(result_bind[2]);
 
     if (mysql_stmt_bind_result(stmt, result_bind))
     {
@@ -115,9 +110,15 @@ std::pair<std::optional<std::vector<Carrier>>, Errors> CarrierModel::getAllCarri
     std::vector<Carrier> carriers;
     do
     {
+        auto carrierPrice = price.value();
+        if (!carrierPrice)
+        {
+            std::cerr << "Invalid price for carrier " << id << " in Carrier Model -getAllCarriers-\n";
+            return {std::nullopt, Errors::FetchFailed};
+        }
         carrier.id = id;
         carrier.name = name;
-        carrier.price = price;
+        carrier.price = *carrierPrice;
         carriers.push_back(carrier);
     } while (mysql_stmt_fetch(stmt) == 0);
 
@@ -126,7 +127,7 @@ std::pair<std::optional<std::vector<Carrier>>, Errors> CarrierModel::getAllCarri
 
 std::pair<std::optional<Carrier>, Errors> CarrierModel::getCarrierById(int &id)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -135,16 +136,11 @@ std::pair<std::optional<Carrier>, Errors> CarrierModel::getCarrierById(int &id)
     }
 
     const char *query = "SELECT id, name, price FROM carriers WHERE id = ?";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Failed to initialize statement" << std::endl;
-        return {std::nullopt, Errors::StatementInitFailed};
-    }
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-    if (mysql_stmt_prepare(stmt, query, strlen(query)))
-    {
-        std::cerr << "Failed to prepare statement: " << mysql_error(conn) << std::endl;
+        std::cerr << "Failed to prepare statement: " << stmt_guard.error() << std::endl;
         return {std::nullopt, Errors::StatementPrepareFailed};
     }
 
@@ -175,7 +171,7 @@ std::pair<std::optional<Carrier>, Errors> CarrierModel::getCarrierById(int &id)
 
     int id_result;
     char name[50];
-    double price;
+    MoneyBind price;
     bool is_null[3];
     unsigned long length[3];
 
@@ -190,10 +186,7 @@ std::pair<std::optional<Carrier>, Errors> CarrierModel::getCarrierById(int &id)
     result_bind[1].is_null = &is_null[1];
     result_bind[1].length = &length[1];
 
-    result_bind[2].buffer_type = MYSQL_TYPE_DOUBLE;
-    result_bind[2].buffer = &price;
-    result_bind[2].is_null = &is_null[2];
-    result_bind[2].length = &length[2];
+    price.bindResult(result_bind[2]);
 
     if (mysql_stmt_bind_result(stmt, result_bind))
     {
@@ -209,9 +202,15 @@ std::pair<std::optional<Carrier>, Errors> CarrierModel::getCarrierById(int &id)
     Carrier carrier;
     do
     {
+        auto carrierPrice = price.value();
+        if (!carrierPrice)
+        {
+            std::cerr << "Invalid price for carrier " << id_result << " in Carrier Model -getCarrierById-\n";
+            return {std::nullopt, Errors::FetchFailed};
+        }
         carrier.id = id_result;
         carrier.name = name;
-        carrier.price = price;
+        carrier.price = *carrierPrice;
     } while (mysql_stmt_fetch(stmt) == 0);
 
     return {carrier, Errors::NoError};
@@ -3,7 +3,7 @@
 std::pair<std::optional<std::vector<Category>>, Errors> CategoryModel::getAllCategories()
 {
 
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
 
     MYSQL *connection = db.getConnection();
 
@@ -15,19 +15,11 @@ std::pair<std::optional<std::vector<Category>>, Errors> CategoryModel::getAllCat
 
     const char *query = "SELECT id, name, description, created_at FROM categories";
 
-    MYSQL_STMT *stmt = mysql_stmt_init(connection);
-
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Failed to initialize statement: " << mysql_error(connection) << std::endl;
-        return {std::nullopt, Errors::StatementInitFailed};
-    }
-
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)))
-    {
-        std::cerr << "Failed to prepare statement: " << mysql_error(connection) << std::endl;
+        std::cerr << "Failed to prepare statement: " << stmt_guard.error() << std::endl;
         return {std::nullopt, Errors::StatementPrepareFailed};
     }
 
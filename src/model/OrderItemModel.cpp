@@ -1,198 +1,146 @@
 #include "model/OrderItemModel.h"
-#include <map>
+#include <algorithm>
+#include "db/MoneyBind.h"
 
-std::optional<int> OrderItemModel::createOrderItem(const std::vector<OrderItem> &products, int order_id)
+bool OrderItemModel::insertOrderItems(PooledConnection &db, const std::vector<OrderItem> &products, int order_id)
 {
-    // Get a database connection instance
-    DatabaseConnection &db = DatabaseConnection::getInstance();
-    MYSQL *conn = db.getConnection();
-    if (!conn)
-    {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        return std::nullopt; // Return null if no connection
-    }
-
-    // Start a transaction
-    if (mysql_query(conn, "START TRANSACTION") != 0)
-    {
-        std::cerr << "Error starting transaction: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-
-    // SQL query for inserting new items into order_items table
-    const char *sql =
-        "INSERT INTO order_items (order_id, product_id, quantity, price) VALUES (?, ?, ?, ?)";
-
-    // Initialize the statement
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
-    if (!stmt)
-    {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Using a smart pointer to automatically manage the resource (stmt)
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    // Prepare the statement for execution
-    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
+    std::vector<int> product_ids;
+    std::vector<int> quantities;
+    std::vector<MoneyBind> prices;
+    std::vector<MYSQL_BIND> param_bind;
 
-    // Iterate through the products and insert them one by one
-    for (const auto &item : products)
+    for (size_t offset = 0; offset < products.size(); offset += kInsertBatchRows)
     {
-        int product_id = item.product_id;
-        int quantity = item.quantity;
-        double price = item.price;
-
-        // Bind parameters to the statement
-        MYSQL_BIND param_bind[4];
-        memset(param_bind, 0, sizeof(param_bind));
+        const size_t count = std::min(kInsertBatchRows, products.size() - offset);
 
-        param_bind[0].buffer_type = MYSQL_TYPE_LONG;
-        param_bind[0].buffer = &order_id;
+        // Cada número de filas es una sentencia distinta en la caché de la conexión
+        // (128 entradas, sin desalojo): se redondea a potencia de dos repitiendo la
+        // última fila, que el ON DUPLICATE KEY vuelve a escribir con los mismos
+        // valores. Así hay como mucho 9 formas (1..256) por conexión.
+        size_t rows = 1;
+        while (rows < count)
+        {
+            rows *= 2;
+        }
 
-        param_bind[1].buffer_type = MYSQL_TYPE_LONG;
-        param_bind[1].buffer = &product_id;
+        std::string sql = "INSERT INTO order_items (order_id, product_id, quantity, price) VALUES ";
+        sql.reserve(sql.size() + rows * 15 + 80);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            sql += i == 0 ? "(?, ?, ?, ?)" : ", (?, ?, ?, ?)";
+        }
+        sql += " ON DUPLICATE KEY UPDATE quantity = VALUES(quantity), price = VALUES(price)";
 
-        param_bind[2].buffer_type = MYSQL_TYPE_LONG;
-        param_bind[2].buffer = &quantity;
+        auto stmt_guard = db.prepare(sql);
+        MYSQL_STMT *stmt = stmt_guard.get();
+        if (!stmt)
+        {
+            std::cerr << "Statement preparation failed: " << stmt_guard.error() << std::endl;
+            return false;
+        }
 
-        param_bind[3].buffer_type = MYSQL_TYPE_DOUBLE;
-        param_bind[3].buffer = &price;
+        // Los buffers deben estar completos antes de enlazarlos: no se redimensionan después
+        product_ids.resize(rows);
+        quantities.resize(rows);
+        prices.resize(rows);
+        param_bind.assign(rows * 4, MYSQL_BIND{});
+        for (size_t i = 0; i < rows; ++i)
+        {
+            const auto &item = products[offset + std::min(i, count - 1)];
+            product_ids[i] = item.product_id;
+            quantities[i] = item.quantity;
+
+            MYSQL_BIND *row = &param_bind[i * 4];
+            row[0].buffer_type = MYSQL_TYPE_LONG;
+            row[0].buffer = &order_id;
+            row[1].buffer_type = MYSQL_TYPE_LONG;
+            row[1].buffer = &product_ids[i];
+            row[2].buffer_type = MYSQL_TYPE_LONG;
+            row[2].buffer = &quantities[i];
+            prices[i].bindParam(row[3], item.price);
+        }
 
-        // Bind parameters to the statement
-        if (mysql_stmt_bind_param(stmt, param_bind) != 0)
+        if (mysql_stmt_bind_param(stmt, param_bind.data()) != 0)
         {
             std::cerr << "Parameter binding failed: " << mysql_stmt_error(stmt) << std::endl;
-            mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-            return std::nullopt;
+            return false;
         }
 
-        // Execute the statement
         if (mysql_stmt_execute(stmt) != 0)
         {
             std::cerr << "Statement execution failed: " << mysql_stmt_error(stmt) << std::endl;
-            mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-            return std::nullopt;
+            return false;
         }
     }
-
-    // Commit the transaction
-    if (mysql_query(conn, "COMMIT") != 0)
-    {
-        std::cerr << "Error committing transaction: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Return the last inserted ID
-    return mysql_insert_id(conn);
+    return true;
 }
 
-std::optional<int> OrderItemModel::updateOrderItems(const std::vector<OrderItem> &products, int order_id)
+bool OrderItemModel::deleteMissingItems(PooledConnection &db, const std::vector<OrderItem> &products, int order_id)
 {
-    // Get a database connection instance
-    DatabaseConnection &db = DatabaseConnection::getInstance();
-    MYSQL *conn = db.getConnection();
-    if (!conn)
+    std::vector<int> keep;
+    keep.reserve(products.size());
+    for (const auto &item : products)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        return std::nullopt; // Return null if no connection
+        keep.push_back(item.product_id);
     }
 
-    // Start a transaction
-    if (mysql_query(conn, "START TRANSACTION") != 0)
+    // La lista NOT IN se rellena hasta la siguiente potencia de dos repitiendo
+    // el último id, para que haya pocas formas de sentencia en la caché
+    std::string sql = "DELETE FROM order_items WHERE order_id = ?";
+    if (!keep.empty())
     {
-        std::cerr << "Error starting transaction: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
+        size_t padded = 1;
+        while (padded < keep.size())
+        {
+            padded *= 2;
+        }
+        keep.resize(padded, keep.back());
 
-    // SQL query for updating items in order_items table
-    const char *sql =
-        "UPDATE order_items SET quantity = ?, price = ? WHERE order_id = ? AND product_id = ?";
+        sql += " AND product_id NOT IN (";
+        for (size_t i = 0; i < keep.size(); ++i)
+        {
+            sql += i == 0 ? "?" : ", ?";
+        }
+        sql += ")";
+    }
 
-    // Initialize the statement
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(sql);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
+        std::cerr << "Statement preparation failed in syncOrderItems: " << stmt_guard.error() << std::endl;
+        return false;
     }
 
-    // Using a smart pointer to automatically manage the resource (stmt)
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    // Prepare the statement for execution
-    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) != 0)
+    std::vector<MYSQL_BIND> param_bind(keep.size() + 1, MYSQL_BIND{});
+    param_bind[0].buffer_type = MYSQL_TYPE_LONG;
+    param_bind[0].buffer = &order_id;
+    for (size_t i = 0; i < keep.size(); ++i)
     {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
+        param_bind[i + 1].buffer_type = MYSQL_TYPE_LONG;
+        param_bind[i + 1].buffer = &keep[i];
     }
 
-    // Iterate through the products and update them
-    for (const auto &item : products)
+    if (mysql_stmt_bind_param(stmt, param_bind.data()) != 0)
     {
-        int product_id = item.product_id;
-        int quantity = item.quantity;
-        double price = item.price;
-
-        // Bind parameters to the statement
-        MYSQL_BIND param_bind[4];
-        memset(param_bind, 0, sizeof(param_bind));
-
-        param_bind[0].buffer_type = MYSQL_TYPE_LONG;
-        param_bind[0].buffer = &quantity;
-
-        param_bind[1].buffer_type = MYSQL_TYPE_DOUBLE;
-        param_bind[1].buffer = &price;
-
-        param_bind[2].buffer_type = MYSQL_TYPE_LONG;
-        param_bind[2].buffer = &order_id;
-
-        param_bind[3].buffer_type = MYSQL_TYPE_LONG;
-        param_bind[3].buffer = &product_id;
-
-        // Bind parameters to the statement
-        if (mysql_stmt_bind_param(stmt, param_bind) != 0)
-        {
-            std::cerr << "Parameter binding failed: " << mysql_stmt_error(stmt) << std::endl;
-            mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-            return std::nullopt;
-        }
-
-        // Execute the statement
-        if (mysql_stmt_execute(stmt) != 0)
-        {
-            std::cerr << "Statement execution failed: " << mysql_stmt_error(stmt) << std::endl;
-            mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-            return std::nullopt;
-        }
+        std::cerr << "Delete binding failed: " << mysql_stmt_error(stmt) << std::endl;
+        return false;
     }
 
-    // Commit the transaction
-    if (mysql_query(conn, "COMMIT") != 0)
+    if (mysql_stmt_execute(stmt) != 0)
     {
-        std::cerr << "Error committing transaction: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
+        std::cerr << "Delete failed: " << mysql_stmt_error(stmt) << std::endl;
+        return false;
     }
-
-    // Return the number of affected rows (updates made)
-    return mysql_affected_rows(conn);
+    return true;
 }
 
+// Sincronización por conjuntos: un upsert con todas las líneas del carrito y
+// un DELETE de las que ya no están, en vez de una sentencia por producto
 std::optional<int> OrderItemModel::syncOrderItems(const std::vector<OrderItem> &newItems, int order_id)
 {
     // Get a database connection instance
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -200,231 +148,23 @@ std::optional<int> OrderItemModel::syncOrderItems(const std::vector<OrderItem> &
         return std::nullopt;
     }
 
-    // Start a transaction
-    if (mysql_query(conn, "START TRANSACTION") != 0)
+    // Si el llamador ya abrió una transacción en esta conexión, se participa en ella
+    const bool ownTransaction = !db.inTransaction();
+    if (ownTransaction && mysql_query(conn, "START TRANSACTION") != 0)
     {
         std::cerr << "Error starting transaction: " << mysql_error(conn) << std::endl;
         return std::nullopt;
     }
 
-    // Get existing items for the given order_id
-    std::map<int, std::pair<int, double>> existingItems;
-    std::string select_query = "SELECT product_id, quantity, price FROM order_items WHERE order_id = ? ";
-
-    MYSQL_STMT *select_stmt = mysql_stmt_init(conn);
-    if (!select_stmt)
-    {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Using a smart pointer to automatically manage the resource (select_stmt)
-    auto select_stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(select_stmt, mysql_stmt_close);
-
-    // Prepare the SELECT statement to get existing items
-    if (mysql_stmt_prepare(select_stmt, select_query.c_str(), select_query.size()) != 0)
-    {
-        std::cerr << "Statement preparation failed in syncOrderItems: " << mysql_stmt_error(select_stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Bind the order_id to the SELECT statement
-    MYSQL_BIND param[1] = {};
-    param[0].buffer_type = MYSQL_TYPE_LONG;
-    param[0].buffer = &order_id;
-
-    if (mysql_stmt_bind_param(select_stmt, param) != 0)
-    {
-        std::cerr << "Parameter binding failed: " << mysql_stmt_error(select_stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Execute the SELECT statement
-    if (mysql_stmt_execute(select_stmt) != 0)
-    {
-        std::cerr << "Statement execution failed: " << mysql_stmt_error(select_stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Prepare to fetch results from the SELECT statement
-    MYSQL_BIND result_bind[3] = {};
-    int product_id;
-    int quantity;
-    double price;
-
-    result_bind[0].buffer_type = MYSQL_TYPE_LONG;
-    result_bind[0].buffer = &product_id;
-    result_bind[1].buffer_type = MYSQL_TYPE_LONG;
-    result_bind[1].buffer = &quantity;
-    result_bind[2].buffer_type = MYSQL_TYPE_DOUBLE;
-    result_bind[2].buffer = &price;
-
-    if (mysql_stmt_bind_result(select_stmt, result_bind) != 0)
-    {
-        std::cerr << "Bind result failed: " << mysql_stmt_error(select_stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Fetch all existing items from the SELECT query and store them in a map
-    while (mysql_stmt_fetch(select_stmt) == 0)
-    {
-        existingItems[product_id] = {quantity, price};
-    }
-    mysql_stmt_free_result(select_stmt);
-
-    if (mysql_stmt_errno(select_stmt) != 0)
-    {
-        std::cerr << "Fetch failed: " << mysql_stmt_error(select_stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Prepare SQL queries for UPDATE, INSERT, and DELETE operations
-    const char *update_sql = "UPDATE order_items SET quantity = ?, price = ? WHERE order_id = ? AND product_id = ?";
-    const char *insert_sql = "INSERT INTO order_items (order_id, product_id, quantity, price) VALUES (?, ?, ?, ?)";
-    const char *delete_sql = "DELETE FROM order_items WHERE order_id = ? AND product_id = ?";
-
-    MYSQL_STMT *update_stmt = mysql_stmt_init(conn);
-    MYSQL_STMT *insert_stmt = mysql_stmt_init(conn);
-    MYSQL_STMT *delete_stmt = mysql_stmt_init(conn);
-
-    if (!update_stmt || !insert_stmt || !delete_stmt)
-    {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Using smart pointers to manage the statement resources
-    auto delete_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(delete_stmt, mysql_stmt_close);
-    auto update_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(update_stmt, mysql_stmt_close);
-    auto insert_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(insert_stmt, mysql_stmt_close);
-
-    // Prepare all the SQL statements
-    if (mysql_stmt_prepare(update_stmt, update_sql, strlen(update_sql)) != 0 ||
-        mysql_stmt_prepare(insert_stmt, insert_sql, strlen(insert_sql)) != 0 ||
-        mysql_stmt_prepare(delete_stmt, delete_sql, strlen(delete_sql)) != 0)
-    {
-        std::cerr << "Statement preparation failed in syncOrderItems: " << mysql_stmt_error(update_stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-        return std::nullopt;
-    }
-
-    // Iterate over the new items to synchronize
-    for (const auto &item : newItems)
-    {
-        int product_id = item.product_id;
-        int new_quantity = item.quantity;
-        double new_price = item.price;
-
-        auto it = existingItems.find(product_id);
-
-        // Check if the product is already in the existing items
-        if (it != existingItems.end())
-        {
-            int existing_quantity = it->second.first;
-            double existing_price = it->second.second;
-
-            // If the quantity or price has changed, perform an UPDATE
-            if (new_quantity != existing_quantity || new_price != existing_price)
-            {
-                // Bind parameters for the UPDATE statement
-                MYSQL_BIND update_bind[4] = {};
-                update_bind[0].buffer_type = MYSQL_TYPE_LONG;
-                update_bind[0].buffer = &new_quantity;
-                update_bind[1].buffer_type = MYSQL_TYPE_DOUBLE;
-                update_bind[1].buffer = &new_price;
-                update_bind[2].buffer_type = MYSQL_TYPE_LONG;
-                update_bind[2].buffer = &order_id;
-                update_bind[3].buffer_type = MYSQL_TYPE_LONG;
-                update_bind[3].buffer = &product_id;
-
-                // Bind parameters to the update statement
-                if (mysql_stmt_bind_param(update_stmt, update_bind) != 0)
-                {
-                    std::cerr << "Update binding failed: " << mysql_stmt_error(update_stmt) << std::endl;
-                    mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-                    return std::nullopt;
-                }
-
-                // Execute the update statement
-                if (mysql_stmt_execute(update_stmt) != 0)
-                {
-                    std::cerr << "Update failed: " << mysql_stmt_error(update_stmt) << std::endl;
-                    mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-                    return std::nullopt;
-                }
-            }
-            existingItems.erase(it); // Remove the item from existingItems after update
-        }
-        else
-        {
-            // If the product is not found, we need to insert a new item
-            // Bind parameters for the INSERT statement
-            MYSQL_BIND insert_bind[4] = {};
-            insert_bind[0].buffer_type = MYSQL_TYPE_LONG;
-            insert_bind[0].buffer = &order_id;
-            insert_bind[1].buffer_type = MYSQL_TYPE_LONG;
-            insert_bind[1].buffer = &product_id;
-            insert_bind[2].buffer_type = MYSQL_TYPE_LONG;
-            insert_bind[2].buffer = &new_quantity;
-            insert_bind[3].buffer_type = MYSQL_TYPE_DOUBLE;
-            insert_bind[3].buffer = &new_price;
-
-            // Bind parameters to the insert statement
-            if (mysql_stmt_bind_param(insert_stmt, insert_bind) != 0)
-            {
-                std::cerr << "Insert binding failed: " << mysql_stmt_error(insert_stmt) << std::endl;
-                mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-                return std::nullopt;
-            }
-
-            // Execute the insert statement
-            if (mysql_stmt_execute(insert_stmt) != 0)
-            {
-                std::cerr << "Insert failed: " << mysql_stmt_error(insert_stmt) << std::endl;
-                mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-                return std::nullopt;
-            }
-        }
-    }
-
-    // Perform a delete for the remaining products in existingItems (which are no longer in newItems)
-    for (const auto &item : existingItems)
+    if (!insertOrderItems(db, newItems, order_id) || !deleteMissingItems(db, newItems, order_id))
     {
-        int product_id = item.first;
-
-        // Bind parameters for the DELETE statement
-        MYSQL_BIND delete_bind[2] = {};
-        delete_bind[0].buffer_type = MYSQL_TYPE_LONG;
-        delete_bind[0].buffer = &order_id;
-        delete_bind[1].buffer_type = MYSQL_TYPE_LONG;
-        delete_bind[1].buffer = &product_id;
-
-        // Bind parameters to the delete statement
-        if (mysql_stmt_bind_param(delete_stmt, delete_bind) != 0)
-        {
-            std::cerr << "Delete binding failed: " << mysql_stmt_error(delete_stmt) << std::endl;
-            mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-            return std::nullopt;
-        }
-
-        // Execute the delete statement
-        if (mysql_stmt_execute(delete_stmt) != 0)
-        {
-            std::cerr << "Delete failed: " << mysql_stmt_error(delete_stmt) << std::endl;
+        if (ownTransaction)
             mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
-            return std::nullopt;
-        }
+        return std::nullopt;
     }
 
     // Commit the transaction
-    if (mysql_query(conn, "COMMIT") != 0)
+    if (ownTransaction && mysql_query(conn, "COMMIT") != 0)
     {
         std::cerr << "Commit failed: " << mysql_error(conn) << std::endl;
         mysql_query(conn, "ROLLBACK"); // Rollback transaction in case of error
@@ -436,9 +176,10 @@ std::optional<int> OrderItemModel::syncOrderItems(const std::vector<OrderItem> &
 
 //---------- CALCULATE ORDER TOTAL ----------
 
-double OrderItemModel::calculateOrderTotal(const std::vector<OrderItem> &products)
+Money OrderItemModel::calculateOrderTotal(const std::vector<OrderItem> &products)
 {
-    double total{0.0};
+    // Suma exacta en céntimos
+    Money total;
     for (const auto &item : products)
     {
         total += item.price * item.quantity;
@@ -450,7 +191,7 @@ double OrderItemModel::calculateOrderTotal(const std::vector<OrderItem> &product
 std::pair<std::optional<std::vector<OrderItem>>, Errors> OrderItemModel::getOrderItemsByOrderId(int &order_id)
 {
 
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -458,19 +199,12 @@ std::pair<std::optional<std::vector<OrderItem>>, Errors> OrderItemModel::getOrde
         return std::make_pair(std::nullopt, Errors::DatabaseConnectionFailed);
     }
 
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
-    if (!stmt)
-    {
-        std::cerr << "Failed to initialize statement" << std::endl;
-        return std::make_pair(std::nullopt, Errors::StatementInitFailed);
-    }
-
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
     const char *sql = "SELECT id, order_id, product_id, quantity, price FROM order_items WHERE order_id = ?";
-    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) != 0)
+    auto stmt_guard = db.prepare(sql);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
     {
-        std::cerr << "Failed to prepare statement" << std::endl;
+        std::cerr << "Failed to prepare statement: " << stmt_guard.error() << std::endl;
         return std::make_pair(std::nullopt, Errors::StatementPrepareFailed);
     }
 
@@ -496,7 +230,7 @@ std::pair<std::optional<std::vector<OrderItem>>, Errors> OrderItemModel::getOrde
     memset(result_bind, 0, sizeof(result_bind));
 
     int id, db_order_id, product_id, quantity;
-    double price;
+    MoneyBind price;
 
     result_bind[0].buffer_type = MYSQL_TYPE_LONG;
     result_bind[0].buffer = &id;
@@ -510,8 +244,7 @@ std::pair<std::optional<std::vector<OrderItem>>, Errors> OrderItemModel::getOrde
     result_bind[3].buffer_type = MYSQL_TYPE_LONG;
     result_bind[3].buffer = &quantity;
 
-    result_bind[4].buffer_type = MYSQL_TYPE_DOUBLE;
-    result_bind[4].buffer = &price;
+    price.bindResult(result_bind[4]);
 
     if (mysql_stmt_bind_result(stmt, result_bind) != 0)
     {
@@ -521,12 +254,18 @@ std::pair<std::optional<std::vector<OrderItem>>, Errors> OrderItemModel::getOrde
 
     while (mysql_stmt_fetch(stmt) == 0)
     {
+        auto itemPrice = price.value();
+        if (!itemPrice)
+        {
+            std::cerr << "Invalid price for order item " << id << std::endl;
+            return std::make_pair(std::nullopt, Errors::FetchFailed);
+        }
         OrderItem orderItem;
         orderItem.id = id;
         orderItem.order_id = db_order_id;
         orderItem.product_id = product_id;
         orderItem.quantity = quantity;
-        orderItem.price = price;
+        orderItem.price = *itemPrice;
         orderItems.push_back(orderItem);
     }
 
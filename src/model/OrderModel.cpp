@@ -1,204 +1,13 @@
 #include "model/OrderModel.h"
+#include "db/MoneyBind.h"
+#include <algorithm>
 
 OrderModel::OrderModel() = default;
 OrderItemModel orderItemModel;
 
-std::optional<int> OrderModel::createOrder(
-    const int user_id,
-    const int &shipping_address_id,
-    const int &billing_address_id,
-    const std::vector<OrderItem> &products,
-    const std::string &shipment_date,
-    const std::string &delivery_date,
-    const int &carrier_id,
-    const std::string &tracking_url,
-    const std::string &tracking_number,
-    const std::string &payment_method,
-    const std::string &payment_status)
-{
-    // Basic validation
-    if (shipping_address_id == 0 || billing_address_id == 0)
-    {
-        std::cerr << "Error: Required fields cannot be empty" << std::endl;
-        return std::nullopt;
-    }
-
-    // Get database connection
-    DatabaseConnection &db = DatabaseConnection::getInstance();
-    MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
-    {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-
-    // Start transaction
-    if (mysql_query(conn, "START TRANSACTION") != 0)
-    {
-        std::cerr << "Error starting transaction createOrder: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-
-    // Prepare the SQL statement
-    const char *sql =
-        "INSERT INTO orders (user_id, shipping_address_id, billing_address_id, status, total, "
-        "shipment_date, delivery_date, carrier_id, tracking_url, tracking_number, payment_method, payment_status) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
-
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
-    if (!stmt)
-    {
-        std::cerr << "Statement initialization failed createOrder: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return std::nullopt;
-    }
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) != 0)
-    {
-        std::cerr << "Statement preparation failed createOrder: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return std::nullopt;
-    }
-
-    // Calculate the total amount
-    double total = orderItemModel.calculateOrderTotal(products);
-
-    // Bind the parameters
-    MYSQL_BIND bind[12];
-    memset(bind, 0, sizeof(bind));
-    bool is_null[12]{};
-    std::string status = "PENDING"; // Default status
-
-    // Set the parameter types and values
-    unsigned long len_status = status.size();
-    unsigned long len_ship_date = shipment_date.size();
-    unsigned long len_deliv_date = delivery_date.size();
-    unsigned long len_track_url = tracking_url.size();
-    unsigned long len_track_number = tracking_number.size();
-    unsigned long len_pay_method = payment_method.size();
-    unsigned long len_pay_status = payment_status.size();
-
-    // 0) user_id
-    bind[0].buffer_type = MYSQL_TYPE_LONG;
-    bind[0].buffer = (void *)&user_id;
-    bind[0].is_null = &is_null[0];
-
-    // 1) shipping_address_id
-    bind[1].buffer_type = MYSQL_TYPE_LONG;
-    bind[1].buffer = (void *)&shipping_address_id;
-    bind[1].is_null = &is_null[1];
-
-    // 2) billing_address_id
-    bind[2].buffer_type = MYSQL_TYPE_LONG;
-    bind[2].buffer = (void *)&billing_address_id;
-    bind[2].is_null = &is_null[2];
-
-    // 3) status
-    bind[3].buffer_type = MYSQL_TYPE_STRING;
-    bind[3].buffer = (void *)status.c_str();
-    bind[3].buffer_length = len_status;
-    bind[3].length = &len_status;
-    bind[3].is_null = &is_null[3];
-
-    // 4) total
-    double total_val = total;
-    bind[4].buffer_type = MYSQL_TYPE_DOUBLE;
-    bind[4].buffer = (void *)&total_val;
-    bind[4].is_null = &is_null[4];
-
-    // 5) shipment_date
-    bind[5].buffer_type = MYSQL_TYPE_STRING;
-    bind[5].buffer = (void *)shipment_date.c_str();
-    bind[5].buffer_length = len_ship_date;
-    bind[5].length = &len_ship_date;
-    bind[5].is_null = &is_null[5];
-
-    // 6) delivery_date
-    bind[6].buffer_type = MYSQL_TYPE_STRING;
-    bind[6].buffer = (void *)delivery_date.c_str();
-    bind[6].buffer_length = len_deliv_date;
-    bind[6].length = &len_deliv_date;
-    bind[6].is_null = &is_null[6];
-
-    // 7) carrier
-    bind[7].buffer_type = MYSQL_TYPE_LONG;
-    bind[7].buffer = (void *)&carrier_id;
-    bind[7].is_null = &is_null[7];
-
-    // 8) tracking_url
-    bind[8].buffer_type = MYSQL_TYPE_STRING;
-    bind[8].buffer = (void *)tracking_url.c_str();
-    bind[8].buffer_length = len_track_url;
-    bind[8].length = &len_track_url;
-    bind[8].is_null = &is_null[8];
-
-    // 9) tracking_number
-    bind[9].buffer_type = MYSQL_TYPE_STRING;
-    bind[9].buffer = (void *)tracking_number.c_str();
-    bind[9].buffer_length = len_track_number;
-    bind[9].length = &len_track_number;
-    bind[9].is_null = &is_null[9];
-
-    // 10) payment_method
-    bind[10].buffer_type = MYSQL_TYPE_STRING;
-    bind[10].buffer = (void *)payment_method.c_str();
-    bind[10].buffer_length = len_pay_method;
-    bind[10].length = &len_pay_method;
-    bind[10].is_null = &is_null[10];
-
-    // 11) payment_status
-    bind[11].buffer_type = MYSQL_TYPE_STRING;
-    bind[11].buffer = (void *)payment_status.c_str();
-    bind[11].buffer_length = len_pay_status;
-    bind[11].length = &len_pay_status;
-    bind[11].is_null = &is_null[11];
-
-    if (mysql_stmt_bind_param(stmt, bind) != 0)
-    {
-        std::cerr << "Parameter binding failed createOrder: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return std::nullopt;
-    }
-
-    if (mysql_stmt_execute(stmt) != 0)
-    {
-        std::cerr << "Statement execution failed createOrder: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return std::nullopt;
-    }
-
-    int order_id = mysql_insert_id(conn);
-
-    if (order_id == 0)
-    {
-        std::cerr << "Error retrieving last insert ID in createOrder: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return std::nullopt;
-    }
-
-    OrderItemModel orderItem;
-    if (!orderItem.createOrderItem(products, order_id))
-    {
-        std::cerr << "Error creating order items: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return std::nullopt;
-    }
-
-    // Commit the transaction
-    if (mysql_query(conn, "COMMIT") != 0)
-    {
-        std::cerr << "Commit failed createOrder: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return std::nullopt;
-    }
-
-    return order_id;
-}
-
 std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
 {
-    auto &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -212,18 +21,11 @@ std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
         "       delivery_date, carrier_id, tracking_url,"
         "       tracking_number, payment_method, payment_status"
         "  FROM orders WHERE user_id = ?";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Init stmt failed: " << mysql_error(conn) << "\n";
-        return std::nullopt;
-    }
-    std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>
-        stmt_guard(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Prepare failed: " << mysql_stmt_error(stmt) << "\n";
+        std::cerr << "Prepare failed: " << stmt_guard.error() << "\n";
         return std::nullopt;
     }
 
@@ -253,7 +55,7 @@ std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
 
     // Buffers para cada columna
     int id, user_id_query, shipping_address_id, billing_address_id, carrier_id;
-    double total;
+    MoneyBind total;
     char order_date[64], status[32];
     char ship_date[64], delivery_date[64];
     char tracking_url[128], tracking_num[64];
@@ -266,7 +68,7 @@ std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
         sizeof(billing_address_id),
         sizeof(order_date),
         sizeof(status),
-        sizeof(total),
+        0, // total: la longitud la lleva MoneyBind
         sizeof(ship_date),
         sizeof(delivery_date),
         sizeof(carrier_id),
@@ -322,11 +124,7 @@ std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
     result_bind[5].length = &length[5];
 
     // Columna 6 → total
-    result_bind[6].buffer_type = MYSQL_TYPE_LONG;
-    result_bind[6].buffer = &total;
-    result_bind[6].buffer_length = sizeof(total);
-    result_bind[6].is_null = &is_null[6];
-    result_bind[6].length = &length[6];
+    total.bindResult(result_bind[6]);
 
     // Columna 7 → ship_date
     result_bind[7].buffer_type = MYSQL_TYPE_STRING;
@@ -388,6 +186,12 @@ std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
     std::vector<Order> orders;
     while (mysql_stmt_fetch(stmt) == 0)
     {
+        auto orderTotal = total.value();
+        if (!orderTotal)
+        {
+            std::cerr << "Invalid total for order " << id << " in OrderModel::getOrdersByUserId" << std::endl;
+            return std::nullopt;
+        }
         Order ord;
         ord.id = id;
         ord.user_id = user_id_query;
@@ -395,7 +199,7 @@ std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
         ord.billing_address_id = billing_address_id;
         ord.order_date = order_date;
         ord.status = status;
-        ord.total = total;
+        ord.total = *orderTotal;
         ord.shipment_date = ship_date;
         ord.delivery_date = delivery_date;
         ord.carrier_id = carrier_id;
@@ -409,897 +213,570 @@ std::optional<std::vector<Order>> OrderModel::getOrdersByUserId(int user_id)
     return orders;
 }
 
-std::optional<Order> OrderModel::getPendingOrderByUserId(int user_id)
+std::pair<std::optional<Order>, Errors> OrderModel::getOrderById(int order_id, int user_id)
 {
-    // Get database connection
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
+        std::cerr << "Error: No active database connection" << std::endl;
+        return {std::nullopt, Errors::DatabaseConnectionFailed};
     }
 
-    // Prepare the SQL statement
+    // Una sola lectura con la propiedad incluida; usa el índice (user_id, id)
     const char *query =
         "SELECT id, user_id, shipping_address_id, billing_address_id,"
         "       order_date, status, total, shipment_date,"
         "       delivery_date, carrier_id, tracking_url,"
-        "       tracking_number, payment_method, payment_status"
-        "  FROM orders WHERE user_id = ? AND status = 'PENDING' LIMIT 1";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+        "       tracking_number, payment_method, payment_status, paypal_order_id, observations"
+        "  FROM orders WHERE id = ? AND user_id = ?";
+
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
-        return std::nullopt;
+        std::cerr << "Statement preparation failed: " << stmt_guard.error() << std::endl;
+        return {std::nullopt, Errors::StatementPrepareFailed};
     }
-    // Bind the parameters
-    MYSQL_BIND param{};
-    param.buffer_type = MYSQL_TYPE_LONG;
-    param.buffer = &user_id;
-    param.buffer_length = sizeof(user_id);
-    param.is_null = 0;
 
-    if (mysql_stmt_bind_param(stmt, &param) != 0)
+    MYSQL_BIND param[2];
+    memset(param, 0, sizeof(param));
+
+    param[0].buffer_type = MYSQL_TYPE_LONG;
+    param[0].buffer = &order_id;
+    param[0].buffer_length = sizeof(order_id);
+
+    param[1].buffer_type = MYSQL_TYPE_LONG;
+    param[1].buffer = &user_id;
+    param[1].buffer_length = sizeof(user_id);
+
+    if (mysql_stmt_bind_param(stmt, param) != 0)
     {
         std::cerr << "Parameter binding failed: " << mysql_stmt_error(stmt) << std::endl;
-        return std::nullopt;
+        return {std::nullopt, Errors::BindParamFailed};
     }
-    // Execute the statement
+
     if (mysql_stmt_execute(stmt) != 0)
     {
         std::cerr << "Statement execution failed: " << mysql_stmt_error(stmt) << std::endl;
-        return std::nullopt;
+        return {std::nullopt, Errors::ExecutionFailed};
     }
 
     if (mysql_stmt_store_result(stmt) != 0)
     {
-        std::cerr << "Error storing result: " << mysql_stmt_error(stmt) << std::endl;
-        return std::nullopt;
+        std::cerr << "Store result failed: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::StoreResultFailed};
     }
 
     // Bind the results
-    MYSQL_BIND result_bind[14];
+    MYSQL_BIND result_bind[16];
     memset(result_bind, 0, sizeof(result_bind));
-    int id, user_id_buffer, shipping_address_id, billing_address_id, carrier_id;
-    double total;
+    int id, user_id_query, shipping_address_id, billing_address_id, carrier_id;
+    MoneyBind total;
     char order_date[64], status[100];
     char ship_date[64], delivery_date[64];
-    char tracking_url[128], tracking_num[64];
-    char pay_method[64], pay_status[32];
-    bool is_null[14]{};
+    char tracking_url[256], tracking_number[64];
+    char payment_method[64], payment_status[64], paypal_order_id[64], observations[256];
+    bool is_null[16]{};
 
-    // Columna 0 → id
     result_bind[0].buffer_type = MYSQL_TYPE_LONG;
     result_bind[0].buffer = &id;
     result_bind[0].buffer_length = sizeof(id);
     result_bind[0].is_null = &is_null[0];
 
-    // Columna 1 → user_id
     result_bind[1].buffer_type = MYSQL_TYPE_LONG;
-    result_bind[1].buffer = &user_id_buffer;
-    result_bind[1].buffer_length = sizeof(user_id_buffer);
+    result_bind[1].buffer = &user_id_query;
+    result_bind[1].buffer_length = sizeof(user_id_query);
     result_bind[1].is_null = &is_null[1];
 
-    // Columna 2 → shipping_address_id
     result_bind[2].buffer_type = MYSQL_TYPE_LONG;
     result_bind[2].buffer = &shipping_address_id;
     result_bind[2].buffer_length = sizeof(shipping_address_id);
     result_bind[2].is_null = &is_null[2];
 
-    // Columna 3 → billing_address_id
     result_bind[3].buffer_type = MYSQL_TYPE_LONG;
     result_bind[3].buffer = &billing_address_id;
     result_bind[3].buffer_length = sizeof(billing_address_id);
     result_bind[3].is_null = &is_null[3];
 
-    // Columna 4 → order_date
     result_bind[4].buffer_type = MYSQL_TYPE_STRING;
     result_bind[4].buffer = order_date;
     result_bind[4].buffer_length = sizeof(order_date);
     result_bind[4].is_null = &is_null[4];
 
-    // Columna 5 → status
     result_bind[5].buffer_type = MYSQL_TYPE_STRING;
     result_bind[5].buffer = status;
     result_bind[5].buffer_length = sizeof(status);
     result_bind[5].is_null = &is_null[5];
 
-    // Columna 6 → total
-    result_bind[6].buffer_type = MYSQL_TYPE_DOUBLE;
-    result_bind[6].buffer = &total;
-    result_bind[6].buffer_length = sizeof(total);
-    result_bind[6].is_null = &is_null[6];
+    total.bindResult(result_bind[6]);
 
-    // Columna 6 → ship_date
     result_bind[7].buffer_type = MYSQL_TYPE_STRING;
     result_bind[7].buffer = ship_date;
     result_bind[7].buffer_length = sizeof(ship_date);
     result_bind[7].is_null = &is_null[7];
 
-    // Columna 7 → delivery_date
     result_bind[8].buffer_type = MYSQL_TYPE_STRING;
     result_bind[8].buffer = delivery_date;
     result_bind[8].buffer_length = sizeof(delivery_date);
     result_bind[8].is_null = &is_null[8];
 
-    // Columna 8 → carrier
     result_bind[9].buffer_type = MYSQL_TYPE_LONG;
     result_bind[9].buffer = &carrier_id;
     result_bind[9].buffer_length = sizeof(carrier_id);
     result_bind[9].is_null = &is_null[9];
 
-    // Columna 9 → tracking_url
     result_bind[10].buffer_type = MYSQL_TYPE_STRING;
     result_bind[10].buffer = tracking_url;
     result_bind[10].buffer_length = sizeof(tracking_url);
     result_bind[10].is_null = &is_null[10];
 
-    // Columna 10 → tracking_num
     result_bind[11].buffer_type = MYSQL_TYPE_STRING;
-    result_bind[11].buffer = tracking_num;
-    result_bind[11].buffer_length = sizeof(tracking_num);
+    result_bind[11].buffer = tracking_number;
+    result_bind[11].buffer_length = sizeof(tracking_number);
     result_bind[11].is_null = &is_null[11];
 
-    // Columna 11 → pay_method
     result_bind[12].buffer_type = MYSQL_TYPE_STRING;
-    result_bind[12].buffer = pay_method;
-    result_bind[12].buffer_length = sizeof(pay_method);
+    result_bind[12].buffer = payment_method;
+    result_bind[12].buffer_length = sizeof(payment_method);
     result_bind[12].is_null = &is_null[12];
 
-    // Columna 13 → pay_status
     result_bind[13].buffer_type = MYSQL_TYPE_STRING;
-    result_bind[13].buffer = pay_status;
-    result_bind[13].buffer_length = sizeof(pay_status);
+    result_bind[13].buffer = payment_status;
+    result_bind[13].buffer_length = sizeof(payment_status);
     result_bind[13].is_null = &is_null[13];
 
+    result_bind[14].buffer_type = MYSQL_TYPE_STRING;
+    result_bind[14].buffer = paypal_order_id;
+    result_bind[14].buffer_length = sizeof(paypal_order_id);
+    result_bind[14].is_null = &is_null[14];
+
+    result_bind[15].buffer_type = MYSQL_TYPE_STRING;
+    result_bind[15].buffer = observations;
+    result_bind[15].buffer_length = sizeof(observations);
+    result_bind[15].is_null = &is_null[15];
+
     // Bind the result
     if (mysql_stmt_bind_result(stmt, result_bind) != 0)
     {
-        std::cerr << "Bind result failed: " << mysql_stmt_error(stmt) << "\n";
-        return std::nullopt;
+        std::cerr << "Result binding failed: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::BindResultFailed};
     }
-    // Fetch the result
-    Order order;
-    int fetch_result = mysql_stmt_fetch(stmt);
-    if (fetch_result == 0 || fetch_result == MYSQL_DATA_TRUNCATED)
+
+    int fetchResult = mysql_stmt_fetch(stmt);
+    if (fetchResult == MYSQL_NO_DATA)
     {
-        // Hay datos: llenar el objeto `Order` y devolverlo
-        order.id = id;
-        order.user_id = user_id;
-        order.shipping_address_id = shipping_address_id;
-        order.billing_address_id = billing_address_id;
-        order.order_date = order_date;
-        order.status = status;
-        order.total = total;
-        order.shipment_date = ship_date;
-        order.delivery_date = delivery_date;
-        order.carrier_id = carrier_id;
-        order.tracking_url = tracking_url;
-        order.tracking_number = tracking_num;
-        order.payment_method = pay_method;
-        order.payment_status = pay_status;
-        return order;
+        // Sin fila para (id, user_id): averiguamos si la orden no existe o es de otro usuario
+        mysql_stmt_free_result(stmt);
+        return {std::nullopt, orderExists(db, order_id) ? Errors::NotOwner : Errors::NoRowsFound};
     }
-    else if (fetch_result == MYSQL_NO_DATA)
+    if (fetchResult != 0 && fetchResult != MYSQL_DATA_TRUNCATED)
     {
-        // No se encontró ninguna orden pendiente para ese user_id
-        std::cout << "No pending order found for user_id: " << user_id << std::endl;
-        return std::nullopt;
+        std::cerr << "Fetch failed OrderModel -getOrderByID-: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::FetchFailed};
     }
-    else
+
+    auto orderTotal = total.value();
+    if (!orderTotal)
     {
-        // Error real
-        std::cerr << "Fetch failed OrderModel::getPendingOrderByUserId: " << mysql_stmt_error(stmt) << std::endl;
-        return std::nullopt;
+        std::cerr << "Invalid total for order " << id << " in OrderModel -getOrderByID-" << std::endl;
+        return {std::nullopt, Errors::FetchFailed};
+    }
+
+    Order order;
+    order.id = id;
+    order.user_id = user_id_query;
+    order.shipping_address_id = shipping_address_id;
+    order.billing_address_id = billing_address_id;
+    order.order_date = order_date;
+    order.status = status;
+    order.total = *orderTotal;
+    order.shipment_date = ship_date;
+    order.delivery_date = delivery_date;
+    order.carrier_id = carrier_id;
+    order.tracking_url = tracking_url;
+    order.tracking_number = tracking_number;
+    order.payment_method = payment_method;
+    order.payment_status = payment_status;
+    order.paypal_order_id = paypal_order_id;
+    order.observations = observations;
+
+    if (is_null[14])
+    {
+        order.paypal_order_id = "";
     }
+
+    mysql_stmt_free_result(stmt);
+    return {order, Errors::NoError};
 }
 
-std::pair<std::optional<Order>, Errors> OrderModel::updateOrder(
-    const int user_id,
-    const int &order_id,
-    const int &shipping_address_id,
-    const int &billing_address_id,
-    const std::vector<OrderItem> &products,
-    const std::string &shipment_date,
-    const std::string &delivery_date,
-    const int &carrier_id,
-    const std::string &tracking_url,
-    const std::string &tracking_number,
-    const std::string &payment_method,
-    const std::string &payment_status)
+bool OrderModel::orderExists(PooledConnection &db, int order_id)
 {
-    // Get database connection
-    DatabaseConnection &db = DatabaseConnection::getInstance();
-    MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    const char *query = "SELECT 1 FROM orders WHERE id = ?";
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        return {std::nullopt, Errors::DatabaseConnectionFailed};
+        std::cerr << "Statement preparation failed in orderExists: " << stmt_guard.error() << std::endl;
+        return false;
     }
 
-    // Start transaction to ensure atomicity
-    if (mysql_query(conn, "START TRANSACTION") != 0)
+    MYSQL_BIND param{};
+    param.buffer_type = MYSQL_TYPE_LONG;
+    param.buffer = &order_id;
+    param.buffer_length = sizeof(order_id);
+
+    if (mysql_stmt_bind_param(stmt, &param) != 0 || mysql_stmt_execute(stmt) != 0 || mysql_stmt_store_result(stmt) != 0)
     {
-        std::cerr << "Error starting transaction checking order exists: " << mysql_error(conn) << std::endl;
-        return {std::nullopt, Errors::TransactionStartFailed};
+        std::cerr << "Query failed in orderExists: " << mysql_stmt_error(stmt) << std::endl;
+        return false;
     }
+    return mysql_stmt_num_rows(stmt) > 0;
+}
 
-    MYSQL_STMT *checkStmt = nullptr;
-    MYSQL_RES *checkResult = nullptr;
+std::optional<int> OrderModel::insertOrderHeader(PooledConnection &db, const Order &order)
+{
+    const char *sql =
+        "INSERT INTO orders (user_id, shipping_address_id, billing_address_id, status, total, "
+        "shipment_date, delivery_date, carrier_id, tracking_url, tracking_number, payment_method, payment_status) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
 
-    try
+    auto stmt_guard = db.prepare(sql);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
     {
-        // Check if the order exists and belongs to the user
-        const char *checkQuery = "SELECT user_id FROM orders WHERE id = ?";
-        checkStmt = mysql_stmt_init(conn);
-        if (!checkStmt)
-        {
-            std::cerr << "Statement initialization failed (check query): " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Statement initialization failed (check query in updateOrder)");
-        }
-        auto checkStmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(checkStmt, mysql_stmt_close);
-        if (mysql_stmt_prepare(checkStmt, checkQuery, strlen(checkQuery)) != 0)
-        {
-            std::cerr << "Statement preparation failed (check query): " << mysql_stmt_error(checkStmt) << std::endl;
-            throw std::runtime_error("Statement preparation failed (check query in updateOrder)");
-        }
-        // Bind the order ID parameter for the check query
-        MYSQL_BIND checkParam[1];
-        int order_id_param = order_id;
-        bool is_null_checkParam[1] = {false};
-        unsigned long lenght_checkParam[1] = {sizeof(order_id_param)};
-
-        memset(checkParam, 0, sizeof(checkParam));
-        checkParam[0].buffer_type = MYSQL_TYPE_LONG;
-        checkParam[0].buffer = (void *)&order_id_param;
-        checkParam[0].buffer_length = sizeof(order_id_param);
-        checkParam[0].is_null = &is_null_checkParam[0];
-        checkParam[0].length = &lenght_checkParam[0];
-
-        if (mysql_stmt_bind_param(checkStmt, checkParam) != 0)
-        {
-            std::cerr << "Parameter binding failed (check query): " << mysql_stmt_error(checkStmt) << std::endl;
-            throw std::runtime_error("Parameter binding failed (check query in updateOrder)");
-        }
-
-        // Execute the check statement
-        if (mysql_stmt_execute(checkStmt) != 0)
-        {
-            std::cerr << "Statement execution failed (check query in updateOrder): " << mysql_stmt_error(checkStmt) << std::endl;
-            throw std::runtime_error("Statement execution failed (check query in updateOrder)");
-        }
+        std::cerr << "Statement preparation failed insertOrderHeader: " << stmt_guard.error() << std::endl;
+        return std::nullopt;
+    }
 
-        // Bind the result for the check query
-        MYSQL_BIND checkResultBind[1];
-        memset(checkResultBind, 0, sizeof(checkResultBind));
-        int user_id_result;
-        bool is_null_result[1];
-        unsigned long lenght_result[1]{sizeof(user_id_result)};
-
-        checkResultBind[0].buffer_type = MYSQL_TYPE_LONG;
-        checkResultBind[0].buffer = &user_id_result;
-        checkResultBind[0].buffer_length = sizeof(user_id_result);
-        checkResultBind[0].is_null = &is_null_result[0];
-        checkResultBind[0].length = &lenght_result[0];
-
-        // Bind the result for the check query
-        if (mysql_stmt_bind_result(checkStmt, checkResultBind) != 0)
-        {
-            std::cerr << "Bind result failed (check query in updateOrder): " << mysql_stmt_error(checkStmt) << "\n";
-            throw std::runtime_error("Bind result failed (check query in updateOrder)");
-        }
-        // Fetch the result of the check query
-        int fetch_result = mysql_stmt_fetch(checkStmt);
-        if (fetch_result == MYSQL_NO_DATA)
-        {
-            std::cerr << "No data found for order_id: " << order_id << "\n";
-            throw std::runtime_error("No data found for order_id");
-        }
-        else if (fetch_result != 0)
-        {
-            std::cerr << "Fetch failed (check query in update Order): " << mysql_stmt_error(checkStmt) << "\n";
-            throw std::runtime_error("Fetch failed (check query in updateOrder)");
-        }
-        // Verify if the fetched user ID matches the provided user ID
-        if (user_id_result != user_id)
-        {
-            std::cerr << "Error: User ID " << user_id << " does not match the order's user ID in (updateOrder) " << user_id_result << std::endl;
-            throw std::runtime_error("User ID does not match");
-        }
+    MYSQL_BIND bind[12];
+    memset(bind, 0, sizeof(bind));
 
-        mysql_stmt_free_result(checkStmt);
+    unsigned long len_status = order.status.size();
+    unsigned long len_ship_date = order.shipment_date.size();
+    unsigned long len_deliv_date = order.delivery_date.size();
+    unsigned long len_track_url = order.tracking_url.size();
+    unsigned long len_track_number = order.tracking_number.size();
+    unsigned long len_pay_method = order.payment_method.size();
+    unsigned long len_pay_status = order.payment_status.size();
 
-        // commit
-        if (mysql_query(conn, "COMMIT") != 0)
-        {
-            std::cerr << "Error committing transaction in checking order exists: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Error committing in checking order exits");
-        }
+    // 0) user_id
+    bind[0].buffer_type = MYSQL_TYPE_LONG;
+    bind[0].buffer = (void *)&order.user_id;
 
-        if (mysql_query(conn, "START TRANSACTION") != 0)
-        {
-            std::cerr << "Error starting transaction update table: " << mysql_error(conn) << std::endl;
-            return {std::nullopt, Errors::TransactionStartFailed};
-        }
+    // 1) shipping_address_id
+    bind[1].buffer_type = MYSQL_TYPE_LONG;
+    bind[1].buffer = (void *)&order.shipping_address_id;
 
-        // Prepare the update statement
-        const char *query = "UPDATE orders "
-                            "SET shipping_address_id = ?, billing_address_id = ?, total = ?, shipment_date = ?, delivery_date = ?, "
-                            "carrier_id = ?, tracking_url = ?, tracking_number = ?, "
-                            "payment_method = ?, payment_status = ? "
-                            "WHERE id = ?";
-        MYSQL_STMT *stmt = mysql_stmt_init(conn);
-        if (!stmt)
-        {
-            std::cerr << "Statement initialization failed (update query): " << mysql_error(conn) << std::endl;
+    // 2) billing_address_id
+    bind[2].buffer_type = MYSQL_TYPE_LONG;
+    bind[2].buffer = (void *)&order.billing_address_id;
 
-            throw std::runtime_error("Statement initialization failed (update query)");
-        }
+    // 3) status
+    bind[3].buffer_type = MYSQL_TYPE_STRING;
+    bind[3].buffer = (void *)order.status.c_str();
+    bind[3].buffer_length = len_status;
+    bind[3].length = &len_status;
 
-        auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
+    // 4) total
+    MoneyBind total_val;
+    total_val.bindParam(bind[4], order.total);
 
-        if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-        {
-            std::cerr << "Statement preparation failed (update query): " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Statement preparation failed (update query)");
-        }
+    // 5) shipment_date
+    bind[5].buffer_type = MYSQL_TYPE_STRING;
+    bind[5].buffer = (void *)order.shipment_date.c_str();
+    bind[5].buffer_length = len_ship_date;
+    bind[5].length = &len_ship_date;
 
-        double total = orderItemModel.calculateOrderTotal(products);
-
-        // Bind the parameters for the update query
-        constexpr size_t NUM_PARAMS = 11;
-        MYSQL_BIND param[NUM_PARAMS];
-        memset(param, 0, sizeof(param));
-        std::string status = "pending";
-        bool is_null[NUM_PARAMS]{};
-        unsigned long lengths[NUM_PARAMS]{};
-
-        // Column 0 → shipping_address_id
-        param[0].buffer_type = MYSQL_TYPE_LONG;
-        param[0].buffer = (void *)&shipping_address_id;
-        param[0].buffer_length = sizeof(shipping_address_id);
-        param[0].is_null = &is_null[0];
-        param[0].length = &lengths[0];
-
-        // Column 1 → billing_address_id
-        param[1].buffer_type = MYSQL_TYPE_LONG;
-        param[1].buffer = (void *)&billing_address_id;
-        param[1].buffer_length = sizeof(billing_address_id);
-        param[1].is_null = &is_null[1];
-        param[1].length = &lengths[1];
+    // 6) delivery_date
+    bind[6].buffer_type = MYSQL_TYPE_STRING;
+    bind[6].buffer = (void *)order.delivery_date.c_str();
+    bind[6].buffer_length = len_deliv_date;
+    bind[6].length = &len_deliv_date;
 
-        // Column 2 → total
-        double total_val = total;
-        param[2].buffer_type = MYSQL_TYPE_DOUBLE;
-        param[2].buffer = (void *)&total_val;
-        param[2].buffer_length = sizeof(total_val);
-        param[2].is_null = &is_null[2];
-        param[2].length = &lengths[2];
-
-        // Column 3 → shipment_date
-        param[3].buffer_type = MYSQL_TYPE_STRING;
-        param[3].buffer = (void *)shipment_date.c_str();
-        param[3].buffer_length = shipment_date.length();
-        param[3].is_null = &is_null[3];
-        param[3].length = &lengths[3];
-
-        // Column 4 → delivery_date
-        param[4].buffer_type = MYSQL_TYPE_STRING;
-        param[4].buffer = (void *)delivery_date.c_str();
-        param[4].buffer_length = delivery_date.length();
-        param[4].is_null = &is_null[4];
-        param[4].length = &lengths[4];
-
-        // Column 5 → carrier
-        param[5].buffer_type = MYSQL_TYPE_LONG;
-        param[5].buffer = (void *)&carrier_id;
-        param[5].buffer_length = sizeof(carrier_id);
-        param[5].is_null = &is_null[5];
-        param[5].length = &lengths[5];
-
-        // Column 6 → tracking_url
-        param[6].buffer_type = MYSQL_TYPE_STRING;
-        param[6].buffer = (void *)tracking_url.c_str();
-        param[6].buffer_length = tracking_url.length();
-        param[6].is_null = &is_null[6];
-        param[6].length = &lengths[6];
-
-        // Column 7 → tracking_number
-        param[7].buffer_type = MYSQL_TYPE_STRING;
-        param[7].buffer = (void *)tracking_number.c_str();
-        param[7].buffer_length = tracking_number.length();
-        param[7].is_null = &is_null[7];
-        param[7].length = &lengths[7];
-
-        // Column 8 → payment_method
-        param[8].buffer_type = MYSQL_TYPE_STRING;
-        param[8].buffer = (void *)payment_method.c_str();
-        param[8].buffer_length = payment_method.length();
-        param[8].is_null = &is_null[8];
-        param[8].length = &lengths[8];
-
-        // Column 9 → payment_status
-        param[9].buffer_type = MYSQL_TYPE_STRING;
-        param[9].buffer = (void *)payment_status.c_str();
-        param[9].buffer_length = payment_status.length();
-        param[9].is_null = &is_null[9];
-        param[9].length = &lengths[9];
-
-        // Column 10 → order_id (for the WHERE clause)
-        param[10].buffer_type = MYSQL_TYPE_LONG;
-        param[10].buffer = (void *)&order_id;
-        param[10].buffer_length = sizeof(order_id);
-        param[10].is_null = &is_null[10];
-        param[10].length = &lengths[10];
-
-        // Bind the parameters for the update query
-        if (mysql_stmt_bind_param(stmt, param) != 0)
-        {
-            std::cerr << "Parameter binding failed (update query): " << mysql_stmt_error(stmt) << std::endl;
+    // 7) carrier
+    bind[7].buffer_type = MYSQL_TYPE_LONG;
+    bind[7].buffer = (void *)&order.carrier_id;
 
-            throw std::runtime_error("Parameter binding failed (update query)");
-        }
+    // 8) tracking_url
+    bind[8].buffer_type = MYSQL_TYPE_STRING;
+    bind[8].buffer = (void *)order.tracking_url.c_str();
+    bind[8].buffer_length = len_track_url;
+    bind[8].length = &len_track_url;
 
-        // Execute the update statement
-        if (mysql_stmt_execute(stmt) != 0)
-        {
-            std::cerr << "Statement execution failed (update query): " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Statement execution failed (update query)");
-        }
+    // 9) tracking_number
+    bind[9].buffer_type = MYSQL_TYPE_STRING;
+    bind[9].buffer = (void *)order.tracking_number.c_str();
+    bind[9].buffer_length = len_track_number;
+    bind[9].length = &len_track_number;
 
-        // Check if any rows were affected by the update
-        if (mysql_stmt_affected_rows(stmt) == 0)
-        {
-            std::cerr << "No rows updated for order_id: " << order_id << std::endl;
-            mysql_query(conn, "ROLLBACK");
-            Order order;
-            order.id = order_id;
-            return {order, Errors::NoRowsAffected};
-        }
+    // 10) payment_method
+    bind[10].buffer_type = MYSQL_TYPE_STRING;
+    bind[10].buffer = (void *)order.payment_method.c_str();
+    bind[10].buffer_length = len_pay_method;
+    bind[10].length = &len_pay_method;
 
-        // Commit the transaction
-        if (mysql_query(conn, "COMMIT") != 0)
-        {
-            std::cerr << "Commit failed: " << mysql_error(conn) << std::endl;
-            mysql_query(conn, "ROLLBACK");
-            throw std::runtime_error("commit failed in update");
-        }
+    // 11) payment_status
+    bind[11].buffer_type = MYSQL_TYPE_STRING;
+    bind[11].buffer = (void *)order.payment_status.c_str();
+    bind[11].buffer_length = len_pay_status;
+    bind[11].length = &len_pay_status;
 
-        // Fetch the updated order
-        Order order;
-        order.id = order_id;
-        order.user_id = user_id;
-        order.shipping_address_id = shipping_address_id;
-        order.billing_address_id = billing_address_id;
-        order.order_date = "";
-        order.total = total;
-        order.shipment_date = shipment_date;
-        order.delivery_date = delivery_date;
-        order.carrier_id = carrier_id;
-        order.tracking_url = tracking_url;
-        order.tracking_number = tracking_number;
-        order.payment_method = payment_method;
-        order.payment_status = payment_status;
-        return {order, Errors::NoError};
+    if (mysql_stmt_bind_param(stmt, bind) != 0)
+    {
+        std::cerr << "Parameter binding failed insertOrderHeader: " << mysql_stmt_error(stmt) << std::endl;
+        return std::nullopt;
     }
-    catch (const std::runtime_error &e)
+
+    if (mysql_stmt_execute(stmt) != 0)
     {
-        std::cerr << "Error during updateOrder catch: " << e.what() << std::endl;
-        if (conn)
-        {
-            mysql_query(conn, "ROLLBACK"); // Rollback on error
-        }
-        return {std::nullopt, Errors::CatchError};
+        std::cerr << "Statement execution failed insertOrderHeader: " << mysql_stmt_error(stmt) << std::endl;
+        return std::nullopt;
     }
-    if (checkStmt)
+
+    int order_id = static_cast<int>(mysql_stmt_insert_id(stmt));
+    if (order_id == 0)
     {
-        mysql_stmt_close(checkStmt);
+        std::cerr << "Error retrieving last insert ID in insertOrderHeader" << std::endl;
+        return std::nullopt;
     }
+    return order_id;
 }
 
-std::optional<Order> OrderModel::getOrderById(int order_id, int user_id)
-
-// Get database connection
+std::pair<bool, Errors> OrderModel::updateOrderHeader(PooledConnection &db, const Order &order)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
-    MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    const char *query = "UPDATE orders "
+                        "SET shipping_address_id = ?, billing_address_id = ?, total = ?, shipment_date = ?, delivery_date = ?, "
+                        "carrier_id = ?, tracking_url = ?, tracking_number = ?, "
+                        "payment_method = ?, payment_status = ? "
+                        "WHERE id = ?";
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        throw std::runtime_error("No active database connection");
+        std::cerr << "Statement preparation failed (update query): " << stmt_guard.error() << std::endl;
+        return {false, Errors::StatementPrepareFailed};
     }
 
-    try
-    {
-
-        // Start transaction to ensure atomicity
-        if (mysql_query(conn, "START TRANSACTION") != 0)
-        {
-            std::cerr << "Error starting transaction order exists: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Error starting transaction getOrderById");
-        }
-        // Check if the order exists
-        const char *checkQuery = "SELECT id FROM orders WHERE id = ?";
-
-        MYSQL_STMT *checkStmt = mysql_stmt_init(conn);
-        if (!checkStmt)
-        {
-            std::cerr << "Statement initialization failed in order exists:: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Statement initialization failed in order exists:");
-        }
-        auto checkStmtGuard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(checkStmt, mysql_stmt_close);
-
-        if (mysql_stmt_prepare(checkStmt, checkQuery, strlen(checkQuery)) != 0)
-        {
-            std::cerr << "Statement preparation failed in order exists:: " << mysql_stmt_error(checkStmt) << std::endl;
-            throw std::runtime_error("Statement preparation failed in order exists:");
-        }
-
-        MYSQL_BIND checkParam{};
-        unsigned long length_checkParam[1]{};
-        checkParam.buffer_type = MYSQL_TYPE_LONG;
-        checkParam.buffer = &order_id;
-        checkParam.buffer_length = sizeof(order_id);
-
-        if (mysql_stmt_bind_param(checkStmt, &checkParam) != 0)
-        {
-            std::cerr << "Parameter binding failed in order exists: " << mysql_stmt_error(checkStmt) << std::endl;
-            throw std::runtime_error("Parameter binding failed in order exists:");
-        }
-        if (mysql_stmt_execute(checkStmt) != 0)
-        {
-            std::cerr << "Statement execution failed in order exists: " << mysql_stmt_error(checkStmt) << std::endl;
-            throw std::runtime_error("Statement execution failed in order exists:");
-        }
-
-        // IMPORTANTE: almacenar el resultado (aunque no lo uses)
-        if (mysql_stmt_store_result(checkStmt) != 0)
-        {
-            std::cerr << "Error storing result in order exists: " << mysql_stmt_error(checkStmt) << std::endl;
-            throw std::runtime_error("Error storing result in order exists");
-        }
-
-        // Intentar fetch para ver si hay alguna fila
-        if (mysql_stmt_fetch(checkStmt) == MYSQL_NO_DATA)
-        {
-            std::cerr << "Order not found in order exists: " << order_id << std::endl;
-            throw std::runtime_error("Order not found in order exists");
-        }
-
-        mysql_stmt_free_result(checkStmt);
-
-        // Commit the transaction
-        if (mysql_query(conn, "COMMIT") != 0)
-        {
-            std::cerr << "Commit failed in order exists: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Commit failed in order exists");
-        }
-
-        // Start a new transaction for fetching the order
-        if (mysql_query(conn, "START TRANSACTION") != 0)
-        {
-            std::cerr << "Error starting transaction CheckUser: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Error starting transaction CheckUser");
-        }
-
-        // Check if the order exists for this user
-        const char *checkUserQuery = "SELECT user_id FROM orders WHERE id = ? and user_id = ?";
-
-        MYSQL_STMT *checkUserStmt = mysql_stmt_init(conn);
-
-        if (!checkUserStmt)
-        {
-            std::cerr << "Statement initialization failed in check user: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Statement initialization failed in check user");
-        }
-
-        auto checkUserStmtGuard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(checkUserStmt, mysql_stmt_close);
-
-        if (mysql_stmt_prepare(checkUserStmt, checkUserQuery, strlen(checkUserQuery)) != 0)
-        {
-            std::cerr << "Statement preparation failed in check user: " << mysql_stmt_error(checkUserStmt) << std::endl;
-            throw std::runtime_error("Statement preparation failed in check user");
-        }
-
-        // Bind the parameters for the check user query
-        MYSQL_BIND checkUserParam[2];
-        bool is_null_checkUserParam[2]{};
-
-        memset(checkUserParam, 0, sizeof(checkUserParam));
-        checkUserParam[0].buffer_type = MYSQL_TYPE_LONG;
-        checkUserParam[0].buffer = &order_id;
-        checkUserParam[0].buffer_length = sizeof(order_id);
-        checkUserParam[0].is_null = &is_null_checkUserParam[0];
-
-        checkUserParam[1].buffer_type = MYSQL_TYPE_LONG;
-        checkUserParam[1].buffer = &user_id;
-        checkUserParam[1].buffer_length = sizeof(user_id);
-        checkUserParam[1].is_null = &is_null_checkUserParam[1];
-
-        // Bind the parameters for the check user query
-        if (mysql_stmt_bind_param(checkUserStmt, checkUserParam) != 0)
-        {
-            std::cerr << "Parameter binding failed in check user: " << mysql_stmt_error(checkUserStmt) << std::endl;
-            throw std::runtime_error("Parameter binding failed in check user");
-        }
-
-        int fetchedUserId;
-
-        // Definir el array de bind para el resultado
-        MYSQL_BIND checkUserResult[1]{};
-
-        bool is_null_checkUser{};
-
-        // Configuramos el tipo de dato y la variable donde se almacenará el resultado
-        checkUserResult[0].buffer_type = MYSQL_TYPE_LONG;
-        checkUserResult[0].buffer = &fetchedUserId; // Es aquí donde almacenaremos el user_id
-        checkUserResult[0].buffer_length = sizeof(fetchedUserId);
-        checkUserResult[0].is_null = &is_null_checkUser;
-
-        // Bind result to the statement
-        if (mysql_stmt_bind_result(checkUserStmt, checkUserResult) != 0)
-        {
-            std::cerr << "Binding result failed: " << mysql_stmt_error(checkUserStmt) << std::endl;
-            throw std::runtime_error("Binding result failed in check user");
-        }
-
-        if (mysql_stmt_execute(checkUserStmt) != 0)
-        {
-            std::cerr << "Statement execution failed in check user: " << mysql_stmt_error(checkUserStmt) << std::endl;
-            throw std::runtime_error("Statement execution failed in check user");
-        }
-
-        if (mysql_stmt_store_result(checkUserStmt) != 0)
-        {
-            std::cerr << "Store result failed (checkUserStmt): " << mysql_stmt_error(checkUserStmt) << std::endl;
-            throw std::runtime_error("Store result failed in checkUserStmt");
-        }
-
-        int fetchResult = mysql_stmt_fetch(checkUserStmt);
-
-        if (fetchResult == MYSQL_NO_DATA)
-        {
-            throw std::runtime_error("Order not found for this user");
-        }
-        else if (fetchResult != 0) // Si hubo un error diferente
-        {
-            std::cerr << "Fetch error: " << mysql_stmt_error(checkUserStmt) << std::endl;
-            throw std::runtime_error("Fetch error in check user");
-        }
-
-        if (fetchedUserId != user_id) // Si los user_id no coinciden
-        {
-            throw std::runtime_error("User ID does not match the order");
-        }
-
-        mysql_stmt_free_result(checkUserStmt);
+    constexpr size_t NUM_PARAMS = 11;
+    MYSQL_BIND param[NUM_PARAMS];
+    memset(param, 0, sizeof(param));
+    unsigned long lengths[NUM_PARAMS]{};
 
-        if (mysql_query(conn, "COMMIT") != 0)
-        {
-            std::cerr << "Commit failed: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Commit failed in check user");
-        }
+    // Column 0 → shipping_address_id
+    param[0].buffer_type = MYSQL_TYPE_LONG;
+    param[0].buffer = (void *)&order.shipping_address_id;
 
-        // Start a new transaction for fetching the order
-        if (mysql_query(conn, "START TRANSACTION") != 0)
-        {
-            std::cerr << "Error starting transaction getOrderById: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Error starting transaction getOrderById");
-        }
+    // Column 1 → billing_address_id
+    param[1].buffer_type = MYSQL_TYPE_LONG;
+    param[1].buffer = (void *)&order.billing_address_id;
+
+    // Column 2 → total
+    MoneyBind total_val;
+    total_val.bindParam(param[2], order.total);
+
+    // Column 3 → shipment_date
+    lengths[3] = order.shipment_date.length();
+    param[3].buffer_type = MYSQL_TYPE_STRING;
+    param[3].buffer = (void *)order.shipment_date.c_str();
+    param[3].buffer_length = lengths[3];
+    param[3].length = &lengths[3];
+
+    // Column 4 → delivery_date
+    lengths[4] = order.delivery_date.length();
+    param[4].buffer_type = MYSQL_TYPE_STRING;
+    param[4].buffer = (void *)order.delivery_date.c_str();
+    param[4].buffer_length = lengths[4];
+    param[4].length = &lengths[4];
+
+    // Column 5 → carrier
+    param[5].buffer_type = MYSQL_TYPE_LONG;
+    param[5].buffer = (void *)&order.carrier_id;
+
+    // Column 6 → tracking_url
+    lengths[6] = order.tracking_url.length();
+    param[6].buffer_type = MYSQL_TYPE_STRING;
+    param[6].buffer = (void *)order.tracking_url.c_str();
+    param[6].buffer_length = lengths[6];
+    param[6].length = &lengths[6];
+
+    // Column 7 → tracking_number
+    lengths[7] = order.tracking_number.length();
+    param[7].buffer_type = MYSQL_TYPE_STRING;
+    param[7].buffer = (void *)order.tracking_number.c_str();
+    param[7].buffer_length = lengths[7];
+    param[7].length = &lengths[7];
+
+    // Column 8 → payment_method
+    lengths[8] = order.payment_method.length();
+    param[8].buffer_type = MYSQL_TYPE_STRING;
+    param[8].buffer = (void *)order.payment_method.c_str();
+    param[8].buffer_length = lengths[8];
+    param[8].length = &lengths[8];
+
+    // Column 9 → payment_status
+    lengths[9] = order.payment_status.length();
+    param[9].buffer_type = MYSQL_TYPE_STRING;
+    param[9].buffer = (void *)order.payment_status.c_str();
+    param[9].buffer_length = lengths[9];
+    param[9].length = &lengths[9];
+
+    // Column 10 → order_id (for the WHERE clause)
+    param[10].buffer_type = MYSQL_TYPE_LONG;
+    param[10].buffer = (void *)&order.id;
 
-        // Prepare the SQL statement
-        const char *query =
-            "SELECT id, user_id, shipping_address_id, billing_address_id,"
-            "       order_date, status, total, shipment_date,"
-            "       delivery_date, carrier_id, tracking_url,"
-            "       tracking_number, payment_method, payment_status, paypal_order_id, observations"
-            "  FROM orders WHERE id = ?";
+    if (mysql_stmt_bind_param(stmt, param) != 0)
+    {
+        std::cerr << "Parameter binding failed (update query): " << mysql_stmt_error(stmt) << std::endl;
+        return {false, Errors::BindParamFailed};
+    }
 
-        MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    if (mysql_stmt_execute(stmt) != 0)
+    {
+        std::cerr << "Statement execution failed (update query): " << mysql_stmt_error(stmt) << std::endl;
+        return {false, Errors::ExecutionFailed};
+    }
 
-        if (!stmt)
-        {
-            std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Statement initialization failed");
-        }
+    if (mysql_stmt_affected_rows(stmt) == 0)
+    {
+        return {true, Errors::NoRowsAffected};
+    }
+    return {true, Errors::NoError};
+}
 
-        auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
+std::pair<std::optional<int>, Errors> OrderModel::lockPendingOrder(PooledConnection &db, int user_id)
+{
+    // La fila del usuario es el punto de serialización: aunque todavía no haya
+    // pedido PENDING, dos peticiones del mismo usuario no pueden crear dos
+    const char *query =
+        "SELECT u.id, o.id FROM users u "
+        "LEFT JOIN orders o ON o.user_id = u.id AND o.status = 'PENDING' "
+        "WHERE u.id = ? ORDER BY o.id LIMIT 1 FOR UPDATE";
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
+    {
+        std::cerr << "Statement preparation failed in lockPendingOrder: " << stmt_guard.error() << std::endl;
+        return {std::nullopt, Errors::StatementPrepareFailed};
+    }
 
-        if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-        {
-            std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Statement preparation failed");
-        }
+    MYSQL_BIND param{};
+    param.buffer_type = MYSQL_TYPE_LONG;
+    param.buffer = &user_id;
 
-        // Bind the parameters
-        MYSQL_BIND param{};
+    if (mysql_stmt_bind_param(stmt, &param) != 0 || mysql_stmt_execute(stmt) != 0)
+    {
+        std::cerr << "Query failed in lockPendingOrder: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::ExecutionFailed};
+    }
 
-        param.buffer_type = MYSQL_TYPE_LONG;
-        param.buffer = &order_id;
-        param.buffer_length = sizeof(order_id);
-        param.is_null = 0;
+    int locked_user_id = 0;
+    int order_id = 0;
+    bool is_null[2]{};
+    MYSQL_BIND result[2];
+    memset(result, 0, sizeof(result));
+    result[0].buffer_type = MYSQL_TYPE_LONG;
+    result[0].buffer = &locked_user_id;
+    result[0].is_null = &is_null[0];
+    result[1].buffer_type = MYSQL_TYPE_LONG;
+    result[1].buffer = &order_id;
+    result[1].is_null = &is_null[1];
+
+    if (mysql_stmt_bind_result(stmt, result) != 0)
+    {
+        std::cerr << "Bind result failed in lockPendingOrder: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::BindResultFailed};
+    }
 
-        if (mysql_stmt_bind_param(stmt, &param) != 0)
-        {
-            std::cerr << "Parameter binding failed: " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Parameter binding failed");
-        }
+    int fetch_result = mysql_stmt_fetch(stmt);
+    if (fetch_result == MYSQL_NO_DATA)
+    {
+        return {std::nullopt, Errors::NoRowsFound}; // el usuario no existe
+    }
+    if (fetch_result != 0 && fetch_result != MYSQL_DATA_TRUNCATED)
+    {
+        std::cerr << "Fetch failed in lockPendingOrder: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::FetchFailed};
+    }
 
-        // Execute the statement
-        if (mysql_stmt_execute(stmt) != 0)
-        {
-            std::cerr << "Statement execution failed: " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Statement execution failed");
-        }
+    if (is_null[1])
+    {
+        return {std::nullopt, Errors::NoError};
+    }
+    return {order_id, Errors::NoError};
+}
 
-        if (mysql_stmt_store_result(stmt) != 0)
-        {
-            std::cerr << "Store result failed: " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Store result failed");
-        }
+std::pair<std::optional<Order>, Errors> OrderModel::upsertPendingOrder(const Order &header, const std::vector<OrderItem> &products, bool &created)
+{
+    created = false;
+    if (header.shipping_address_id == 0 || header.billing_address_id == 0)
+    {
+        std::cerr << "Error: Required fields cannot be empty" << std::endl;
+        return {std::nullopt, Errors::InvalidArgument};
+    }
 
-        // Bind the results
-        MYSQL_BIND result_bind[16];
-        memset(result_bind, 0, sizeof(result_bind));
-        int id, user_id_query, shipping_address_id, billing_address_id, carrier_id;
-        double total;
-        char order_date[64], status[100];
-        char ship_date[64], delivery_date[64];
-        char tracking_url[256], tracking_number[64];
-        char payment_method[64], payment_status[64], paypal_order_id[64], observations[256];
-        bool is_null[16]{};
-
-        result_bind[0].buffer_type = MYSQL_TYPE_LONG;
-        result_bind[0].buffer = &id;
-        result_bind[0].buffer_length = sizeof(id);
-        result_bind[0].is_null = &is_null[0];
-
-        result_bind[1].buffer_type = MYSQL_TYPE_LONG;
-        result_bind[1].buffer = &user_id_query;
-        result_bind[1].buffer_length = sizeof(user_id_query);
-        result_bind[1].is_null = &is_null[1];
-
-        result_bind[2].buffer_type = MYSQL_TYPE_LONG;
-        result_bind[2].buffer = &shipping_address_id;
-        result_bind[2].buffer_length = sizeof(shipping_address_id);
-        result_bind[2].is_null = &is_null[2];
-
-        result_bind[3].buffer_type = MYSQL_TYPE_LONG;
-        result_bind[3].buffer = &billing_address_id;
-        result_bind[3].buffer_length = sizeof(billing_address_id);
-        result_bind[3].is_null = &is_null[3];
-
-        result_bind[4].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[4].buffer = order_date;
-        result_bind[4].buffer_length = sizeof(order_date);
-        result_bind[4].is_null = &is_null[4];
-
-        result_bind[5].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[5].buffer = status;
-        result_bind[5].buffer_length = sizeof(status);
-        result_bind[5].is_null = &is_null[5];
-
-        result_bind[6].buffer_type = MYSQL_TYPE_DOUBLE;
-        result_bind[6].buffer = &total;
-        result_bind[6].buffer_length = sizeof(total);
-        result_bind[6].is_null = &is_null[6];
-
-        result_bind[7].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[7].buffer = ship_date;
-        result_bind[7].buffer_length = sizeof(ship_date);
-        result_bind[7].is_null = &is_null[7];
-
-        result_bind[8].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[8].buffer = delivery_date;
-        result_bind[8].buffer_length = sizeof(delivery_date);
-        result_bind[8].is_null = &is_null[8];
-
-        result_bind[9].buffer_type = MYSQL_TYPE_LONG;
-        result_bind[9].buffer = &carrier_id;
-        result_bind[9].buffer_length = sizeof(carrier_id);
-        result_bind[9].is_null = &is_null[9];
-
-        result_bind[10].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[10].buffer = tracking_url;
-        result_bind[10].buffer_length = sizeof(tracking_url);
-        result_bind[10].is_null = &is_null[10];
-
-        result_bind[11].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[11].buffer = tracking_number;
-        result_bind[11].buffer_length = sizeof(tracking_number);
-        result_bind[11].is_null = &is_null[11];
-
-        result_bind[12].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[12].buffer = payment_method;
-        result_bind[12].buffer_length = sizeof(payment_method);
-        result_bind[12].is_null = &is_null[12];
-
-        result_bind[13].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[13].buffer = payment_status;
-        result_bind[13].buffer_length = sizeof(payment_status);
-        result_bind[13].is_null = &is_null[13];
-
-        result_bind[14].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[14].buffer = paypal_order_id;
-        result_bind[14].buffer_length = sizeof(paypal_order_id);
-        result_bind[14].is_null = &is_null[14];
-
-        result_bind[15].buffer_type = MYSQL_TYPE_STRING;
-        result_bind[15].buffer = observations;
-        result_bind[15].buffer_length = sizeof(observations);
-        result_bind[15].is_null = &is_null[15];
-
-        // Bind the result
-        if (mysql_stmt_bind_result(stmt, result_bind) != 0)
-        {
-            std::cerr << "Result binding failed: " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Result binding failed");
-        }
-        if (mysql_stmt_fetch(stmt) != 0)
-        {
-            std::cerr << "Fetch failed OrderModel -getOrderByID-: " << mysql_stmt_error(stmt) << std::endl;
-            throw std::runtime_error("Fetch failed OrderModel -getOrderByID-");
-        }
+    auto db = ConnectionPool::getInstance().acquire();
+    MYSQL *conn = db.getConnection();
+    if (!conn)
+    {
+        std::cerr << "Error: No active database connection" << std::endl;
+        return {std::nullopt, Errors::DatabaseConnectionFailed};
+    }
 
-        Order order;
-        order.id = id;
-        order.user_id = user_id_query;
-        order.shipping_address_id = shipping_address_id;
-        order.billing_address_id = billing_address_id;
-        order.order_date = order_date;
-        order.status = status;
-        order.total = total;
-        order.shipment_date = ship_date;
-        order.delivery_date = delivery_date;
-        order.carrier_id = carrier_id;
-        order.tracking_url = tracking_url;
-        order.tracking_number = tracking_number;
-        order.payment_method = payment_method;
-        order.payment_status = payment_status;
-        order.paypal_order_id = paypal_order_id;
-        order.observations = observations;
-        // Commit the transaction
+    if (mysql_query(conn, "START TRANSACTION") != 0)
+    {
+        std::cerr << "Error starting transaction upsertPendingOrder: " << mysql_error(conn) << std::endl;
+        return {std::nullopt, Errors::TransactionStartFailed};
+    }
 
-        if (is_null[14])
-        {
-            order.paypal_order_id = "";
-        }
+    auto [pendingId, lockError] = lockPendingOrder(db, header.user_id);
+    if (lockError != Errors::NoError)
+    {
+        mysql_query(conn, "ROLLBACK");
+        return {std::nullopt, lockError};
+    }
 
-        mysql_stmt_free_result(stmt);
+    Order order = header;
+    order.status = "PENDING";
+    order.total = orderItemModel.calculateOrderTotal(products);
 
-        if (mysql_query(conn, "COMMIT") != 0)
-        {
-            std::cerr << "Commit failed: " << mysql_error(conn) << std::endl;
-            throw std::runtime_error("Commit failed");
-        }
-        return order;
+    bool written = false;
+    if (pendingId)
+    {
+        order.id = *pendingId;
+        written = updateOrderHeader(db, order).first;
     }
-    catch (const std::exception &e)
+    else
+    {
+        auto newId = insertOrderHeader(db, order);
+        written = newId.has_value();
+        if (newId)
+            order.id = *newId;
+    }
+
+    // La conexión prestada es la misma y ya hay transacción: las líneas se
+    // escriben dentro de ella
+    if (!written || !orderItemModel.syncOrderItems(products, order.id))
     {
         mysql_query(conn, "ROLLBACK");
-        std::cerr << "Error in getOrderById: " << e.what() << std::endl;
-        return std::nullopt;
+        return {std::nullopt, Errors::ExecutionFailed};
     }
-    catch (...)
+
+    if (mysql_query(conn, "COMMIT") != 0)
     {
+        std::cerr << "Commit failed upsertPendingOrder: " << mysql_error(conn) << std::endl;
         mysql_query(conn, "ROLLBACK");
-        std::cerr << "Unknown error in getOrderById" << std::endl;
-        return std::nullopt;
+        return {std::nullopt, Errors::CommitFailed};
     }
-    // Get database connection
+
+    created = !pendingId.has_value();
+    return {order, Errors::NoError};
 }
 
 std::pair<std::optional<Order>, Errors> OrderModel::updateOrderPaypalId(const int user_id, const int &order_id, const std::string &payment_id)
 {
     // Get database connection
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
 
     if (!conn)
@@ -1320,17 +797,11 @@ std::pair<std::optional<Order>, Errors> OrderModel::updateOrderPaypalId(const in
         }
         // Prepare the SQL statement
         const char *sql = "UPDATE orders SET paypal_order_id = ? WHERE user_id = ? AND id = ?";
-        MYSQL_STMT *stmt = mysql_stmt_init(conn);
+        auto stmt_guard = db.prepare(sql);
+        MYSQL_STMT *stmt = stmt_guard.get();
         if (!stmt)
         {
-            std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-            mysql_query(conn, "ROLLBACK");
-            return std::make_pair(std::nullopt, Errors::StatementInitFailed);
-        }
-        auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-        if (mysql_stmt_prepare(stmt, sql, strlen(sql)) != 0)
-        {
-            std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
+            std::cerr << "Statement preparation failed: " << stmt_guard.error() << std::endl;
             mysql_query(conn, "ROLLBACK");
             return std::make_pair(std::nullopt, Errors::StatementPrepareFailed);
         }
@@ -1403,163 +874,120 @@ std::pair<std::optional<Order>, Errors> OrderModel::updateOrderPaypalId(const in
     }
 }
 
-std::pair<bool, Errors> OrderModel::updateOrderTotal(int order_id, double total)
+std::pair<std::optional<Money>, Errors> OrderModel::selectCarrier(int order_id, int user_id, int carrier_id)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
-    {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        return {false, Errors::DatabaseConnectionFailed};
-    }
-
-    if (mysql_query(conn, "START TRANSACTION") != 0)
+    if (!conn)
     {
-        std::cerr << "Error starting transaction in updateOrderTotal: " << mysql_error(conn) << std::endl;
-        return {false, Errors::TransactionStartFailed};
+        std::cerr << "Error: No active database connection" << std::endl;
+        return {std::nullopt, Errors::DatabaseConnectionFailed};
     }
 
-    const char *query = "UPDATE orders SET total = ? WHERE id = ?";
-
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
-
+    // Una sola sentencia atómica: el total se recalcula en el servidor a
+    // partir de las líneas más el envío, así que repetirla no suma dos veces
+    const char *query =
+        "UPDATE orders o JOIN carriers c ON c.id = ? "
+        "SET o.carrier_id = c.id, "
+        "    o.total = c.price + (SELECT COALESCE(SUM(oi.quantity * oi.price), 0) "
+        "                          FROM order_items oi WHERE oi.order_id = o.id) "
+        "WHERE o.id = ? AND o.user_id = ? AND o.status = 'PENDING'";
+
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement init failed in updateOrderTotal: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::StatementInitFailed};
+        std::cerr << "Statement prepare failed in selectCarrier: " << stmt_guard.error() << std::endl;
+        return {std::nullopt, Errors::StatementPrepareFailed};
     }
 
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Statement prepare failed in updateOrderTotal: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::StatementPrepareFailed};
-    }
-
-    MYSQL_BIND param[2];
+    MYSQL_BIND param[3];
     memset(param, 0, sizeof(param));
-    bool is_null[2]{};
-
-    param[0].buffer_type = MYSQL_TYPE_DOUBLE;
-    param[0].buffer = &total;
-    param[0].buffer_length = sizeof(total);
-    param[0].is_null = &is_null[0];
-
+    param[0].buffer_type = MYSQL_TYPE_LONG;
+    param[0].buffer = &carrier_id;
     param[1].buffer_type = MYSQL_TYPE_LONG;
     param[1].buffer = &order_id;
-    param[1].buffer_length = sizeof(order_id);
-    param[1].is_null = &is_null[1];
+    param[2].buffer_type = MYSQL_TYPE_LONG;
+    param[2].buffer = &user_id;
 
     if (mysql_stmt_bind_param(stmt, param) != 0)
     {
-        std::cerr << "Parameter binding failed in updateOrderTotal: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::BindParamFailed};
+        std::cerr << "Parameter binding failed in selectCarrier: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::BindParamFailed};
     }
 
     if (mysql_stmt_execute(stmt) != 0)
     {
-        std::cerr << "Statement execution failed in updateOrderTotal: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::ExecutionFailed};
-    }
-
-    if (mysql_stmt_affected_rows(stmt) == 0)
-    {
-        std::cerr << "No rows updated in updateOrderTotal: " << mysql_stmt_error(stmt) << std::endl;
-        return {true, Errors::NoRowsAffected};
-    }
-
-    if (mysql_query(conn, "COMMIT") != 0)
-    {
-        std::cerr << "Commit failed in updateOrderTotal: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::CommitFailed};
+        std::cerr << "Statement execution failed in selectCarrier: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::ExecutionFailed};
     }
 
-    return {true, Errors::NoError};
-}
-
-std::pair<bool, Errors> OrderModel::updateCarrierId(int order_id, int carrier_id)
-{
-
-    DatabaseConnection &db = DatabaseConnection::getInstance();
-    MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    // Lectura del resultado: 0 filas afectadas puede ser un reintento sin
+    // cambios, un transportista inexistente, un pedido ajeno o ya no PENDING
+    const char *readQuery = "SELECT total, carrier_id, status FROM orders WHERE id = ? AND user_id = ?";
+    auto read_guard = db.prepare(readQuery);
+    MYSQL_STMT *readStmt = read_guard.get();
+    if (!readStmt)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
-        return {false, Errors::DatabaseConnectionFailed};
+        std::cerr << "Statement prepare failed in selectCarrier: " << read_guard.error() << std::endl;
+        return {std::nullopt, Errors::StatementPrepareFailed};
     }
 
-    if (mysql_query(conn, "START TRANSACTION") != 0)
+    if (mysql_stmt_bind_param(readStmt, &param[1]) != 0 || mysql_stmt_execute(readStmt) != 0)
     {
-        std::cerr << "Error starting transaction in updateOrderTotal: " << mysql_error(conn) << std::endl;
-        return {false, Errors::TransactionStartFailed};
+        std::cerr << "Query failed in selectCarrier: " << mysql_stmt_error(readStmt) << std::endl;
+        return {std::nullopt, Errors::ExecutionFailed};
     }
 
-    const char *query = "UPDATE orders SET carrier_id = ? WHERE id = ?";
-
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
-    if (!stmt)
+    MYSQL_BIND result[3];
+    memset(result, 0, sizeof(result));
+    MoneyBind total;
+    total.bindResult(result[0]);
+    int current_carrier_id = 0;
+    bool carrier_is_null = false;
+    result[1].buffer_type = MYSQL_TYPE_LONG;
+    result[1].buffer = &current_carrier_id;
+    result[1].is_null = &carrier_is_null;
+    char status[32] = {0};
+    unsigned long status_length = 0;
+    result[2].buffer_type = MYSQL_TYPE_STRING;
+    result[2].buffer = status;
+    result[2].buffer_length = sizeof(status);
+    result[2].length = &status_length;
+
+    if (mysql_stmt_bind_result(readStmt, result) != 0)
     {
-        std::cerr << "Statement init failed in updateOrderTotal: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::StatementInitFailed};
+        std::cerr << "Bind result failed in selectCarrier: " << mysql_stmt_error(readStmt) << std::endl;
+        return {std::nullopt, Errors::BindResultFailed};
     }
 
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
+    int fetch_result = mysql_stmt_fetch(readStmt);
+    if (fetch_result == MYSQL_NO_DATA)
     {
-        std::cerr << "Statement prepare failed in updateOrderTotal: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::StatementPrepareFailed};
+        return {std::nullopt, Errors::NoRowsFound};
     }
-
-    MYSQL_BIND param[2];
-    memset(param, 0, sizeof(param));
-    bool is_null[2] = {false, false};
-
-    param[0].buffer_type = MYSQL_TYPE_LONG;
-    param[0].buffer = &carrier_id;
-    param[0].buffer_length = sizeof(carrier_id);
-    param[0].is_null = &is_null[0];
-
-    param[1].buffer_type = MYSQL_TYPE_LONG;
-    param[1].buffer = &order_id;
-    param[1].buffer_length = sizeof(order_id);
-    param[1].is_null = &is_null[1];
-
-    if (mysql_stmt_bind_param(stmt, param) != 0)
+    if (fetch_result != 0)
     {
-        std::cerr << "Parameter binding failed in updateOrderTotal: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::BindParamFailed};
+        std::cerr << "Fetch failed in selectCarrier: " << mysql_stmt_error(readStmt) << std::endl;
+        return {std::nullopt, Errors::FetchFailed};
     }
 
-    if (mysql_stmt_execute(stmt) != 0)
+    // Un pedido pagado o cancelado no cambia de transportista ni de total
+    if (std::string(status, std::min<unsigned long>(status_length, sizeof(status))) != "PENDING")
     {
-        std::cerr << "Statement execution failed in updateOrderTotal: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::ExecutionFailed};
+        return {std::nullopt, Errors::InvalidState};
     }
-
-    if (mysql_stmt_affected_rows(stmt) == 0)
+    if (carrier_is_null || current_carrier_id != carrier_id)
     {
-        return {true, Errors::NoRowsAffected};
+        return {std::nullopt, Errors::InvalidArgument}; // el transportista no existe
     }
-
-    if (mysql_query(conn, "COMMIT") != 0)
+    auto orderTotal = total.value();
+    if (!orderTotal)
     {
-        std::cerr << "Commit failed in updateOrderTotal: " << mysql_error(conn) << std::endl;
-        mysql_query(conn, "ROLLBACK");
-        return {false, Errors::CommitFailed};
+        std::cerr << "Invalid total for order " << order_id << " in selectCarrier" << std::endl;
+        return {std::nullopt, Errors::FetchFailed};
     }
-
-    return {true, Errors::NoError};
+    return {orderTotal, Errors::NoError};
 }
 
 std::pair<std::optional<Order>, Errors> OrderModel::updateOrderStatus(
@@ -1567,11 +995,11 @@ std::pair<std::optional<Order>, Errors> OrderModel::updateOrderStatus(
     int order_id,
     const std::string &status)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection: " << mysql_error(conn) << std::endl;
+        std::cerr << "Error: No active database connection" << std::endl;
         return {std::nullopt, Errors::DatabaseConnectionFailed};
     }
 
@@ -1587,19 +1015,11 @@ std::pair<std::optional<Order>, Errors> OrderModel::updateOrderStatus(
 
         // Update order status
         const char *query = "UPDATE orders SET status = ? WHERE id = ? AND user_id = ?";
-        MYSQL_STMT *stmt = mysql_stmt_init(conn);
+        auto stmt_guard = db.prepare(query);
+        MYSQL_STMT *stmt = stmt_guard.get();
         if (!stmt)
         {
-            std::cerr << "Statement init failed: " << mysql_error(conn) << std::endl;
-            mysql_query(conn, "ROLLBACK");
-            return {std::nullopt, Errors::StatementInitFailed};
-        }
-
-        auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-        if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-        {
-            std::cerr << "Statement prepare failed: " << mysql_stmt_error(stmt) << std::endl;
+            std::cerr << "Statement prepare failed: " << stmt_guard.error() << std::endl;
             mysql_query(conn, "ROLLBACK");
             return {std::nullopt, Errors::StatementPrepareFailed};
         }
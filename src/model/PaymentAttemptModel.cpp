@@ -1,8 +1,9 @@
 #include "model/PaymentAttemptModel.h"
+#include "db/MoneyBind.h"
 
-std::pair<std::optional<PaymentAttempt>, Errors> PaymentAttempModel::createPaymentAttempt(int user_id, int order_id, std::string cart_hash, double total, std::string idempotency_key, std::string paypal_order_id, std::string status)
+std::pair<std::optional<PaymentAttempt>, Errors> PaymentAttempModel::createPaymentAttempt(int user_id, int order_id, std::string cart_hash, const Money &total, std::string idempotency_key, std::string paypal_order_id, std::string status)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -10,19 +11,18 @@ std::pair<std::optional<PaymentAttempt>, Errors> PaymentAttempModel::createPayme
         return std::make_pair(std::nullopt, Errors::DatabaseConnectionFailed);
     }
 
-    const char *query = "INSERT INTO payment_attempts (user_id, order_id, cart_hash, total, idempotency_key, paypal_order_id, status) VALUES (?, ?, ?, ?, ?, ?, ?)";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    // Un intento previo con el mismo carrito (clave unique_attempt) se reutiliza:
+    // LAST_INSERT_ID(id) hace que insert_id devuelva su id
+    const char *query =
+        "INSERT INTO payment_attempts (user_id, order_id, cart_hash, total, idempotency_key, paypal_order_id, status) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?) "
+        "ON DUPLICATE KEY UPDATE id = LAST_INSERT_ID(id), order_id = VALUES(order_id), total = VALUES(total), "
+        "idempotency_key = VALUES(idempotency_key), paypal_order_id = VALUES(paypal_order_id), status = VALUES(status)";
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Failed to initialize statement" << std::endl;
-        return std::make_pair(std::nullopt, Errors::StatementInitFailed);
-    }
-
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Failed to prepare statement: " << mysql_error(conn) << std::endl;
+        std::cerr << "Failed to prepare statement: " << stmt_guard.error() << std::endl;
         return std::make_pair(std::nullopt, Errors::StatementPrepareFailed);
     }
 
@@ -44,8 +44,8 @@ std::pair<std::optional<PaymentAttempt>, Errors> PaymentAttempModel::createPayme
     bind[2].buffer = (char *)cart_hash.c_str();
     bind[2].buffer_length = len_cart_hash;
 
-    bind[3].buffer_type = MYSQL_TYPE_DOUBLE;
-    bind[3].buffer = &total;
+    MoneyBind total_val;
+    total_val.bindParam(bind[3], total);
 
     bind[4].buffer_type = MYSQL_TYPE_STRING;
     bind[4].buffer = (char *)idempotency_key.c_str();
@@ -83,9 +83,9 @@ std::pair<std::optional<PaymentAttempt>, Errors> PaymentAttempModel::createPayme
 
     return std::make_pair(paymentAttempt, Errors::NoError);
 }
-std::pair<std::optional<std::vector<PaymentAttempt>>, Errors> PaymentAttempModel::getPaymentAttemptsByOrderId(int order_id)
+std::pair<std::optional<PaymentAttempt>, Errors> PaymentAttempModel::getLatestPaymentAttempt(int order_id, const std::string &cart_hash)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -93,103 +93,70 @@ std::pair<std::optional<std::vector<PaymentAttempt>>, Errors> PaymentAttempModel
         return {std::nullopt, Errors::DatabaseConnectionFailed};
     }
 
+    // Resuelta entera desde idx_payment_attempts_lookup, sin leer la tabla
     const char *query =
-        "SELECT id, user_id, order_id, cart_hash, total, idempotency_key, paypal_order_id, status"
+        "SELECT id, idempotency_key, paypal_order_id"
         "  FROM payment_attempts"
-        " WHERE order_id = ? AND status = 'PAYER_ACTION_REQUIRED'";
+        " WHERE order_id = ? AND cart_hash = ? AND status = 'PAYER_ACTION_REQUIRED'"
+        " ORDER BY id DESC LIMIT 1";
 
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Failed to initialize statement" << std::endl;
-        return {std::nullopt, Errors::StatementInitFailed};
-    }
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Failed to prepare statement: " << mysql_error(conn) << std::endl;
+        std::cerr << "Failed to prepare statement: " << stmt_guard.error() << std::endl;
         return {std::nullopt, Errors::StatementPrepareFailed};
     }
 
-    MYSQL_BIND bind_param[1];
+    unsigned long cart_hash_len = cart_hash.size();
+    MYSQL_BIND bind_param[2];
     memset(bind_param, 0, sizeof(bind_param));
     bind_param[0].buffer_type = MYSQL_TYPE_LONG;
     bind_param[0].buffer = &order_id;
-    bind_param[0].buffer_length = sizeof(order_id);
+    bind_param[1].buffer_type = MYSQL_TYPE_STRING;
+    bind_param[1].buffer = (char *)cart_hash.c_str();
+    bind_param[1].buffer_length = cart_hash_len;
+    bind_param[1].length = &cart_hash_len;
+
     if (mysql_stmt_bind_param(stmt, bind_param) != 0)
     {
-        std::cerr << "Failed to bind parameters: " << mysql_error(conn) << std::endl;
+        std::cerr << "Failed to bind parameters: " << mysql_stmt_error(stmt) << std::endl;
         return {std::nullopt, Errors::BindParamFailed};
     }
 
     if (mysql_stmt_execute(stmt) != 0)
     {
-        std::cerr << "Failed to execute statement: " << mysql_error(conn) << std::endl;
+        std::cerr << "Failed to execute statement: " << mysql_stmt_error(stmt) << std::endl;
         return {std::nullopt, Errors::ExecutionFailed};
     }
 
-    // Allocate result buffers
-    MYSQL_BIND result_bind[8];
-    memset(result_bind, 0, sizeof(result_bind));
+    int id = 0;
+    char idemp_key_buf[64];
+    char paypal_order_buf[100];
+    unsigned long length[3]{};
+    bool is_null[3]{};
 
-    int id;
-    int user_id_buf;
-    int order_id_buf;
-    double total;
-    char cart_hash_buf[256];
-    char idemp_key_buf[256];
-    char paypal_order_buf[256];
-    char status_buf[64];
-    bool is_null[8];
+    MYSQL_BIND result_bind[3];
+    memset(result_bind, 0, sizeof(result_bind));
 
     // id
     result_bind[0].buffer_type = MYSQL_TYPE_LONG;
     result_bind[0].buffer = &id;
-    result_bind[0].buffer_length = sizeof(id);
     result_bind[0].is_null = &is_null[0];
 
-    // user_id
-    result_bind[1].buffer_type = MYSQL_TYPE_LONG;
-    result_bind[1].buffer = &user_id_buf;
-    result_bind[1].buffer_length = sizeof(user_id_buf);
-    result_bind[1].is_null = &is_null[1];
-
-    // order_id
-    result_bind[2].buffer_type = MYSQL_TYPE_LONG;
-    result_bind[2].buffer = &order_id_buf;
-    result_bind[2].buffer_length = sizeof(order_id_buf);
-    result_bind[2].is_null = &is_null[2];
-
-    // cart_hash
-    result_bind[3].buffer_type = MYSQL_TYPE_STRING;
-    result_bind[3].buffer = cart_hash_buf;
-    result_bind[3].buffer_length = sizeof(cart_hash_buf);
-    result_bind[3].is_null = &is_null[3];
-
-    // total
-    result_bind[4].buffer_type = MYSQL_TYPE_DOUBLE;
-    result_bind[4].buffer = &total;
-    result_bind[4].buffer_length = sizeof(total);
-    result_bind[4].is_null = &is_null[4];
-
     // idempotency_key
-    result_bind[5].buffer_type = MYSQL_TYPE_STRING;
-    result_bind[5].buffer = idemp_key_buf;
-    result_bind[5].buffer_length = sizeof(idemp_key_buf);
-    result_bind[5].is_null = &is_null[5];
+    result_bind[1].buffer_type = MYSQL_TYPE_STRING;
+    result_bind[1].buffer = idemp_key_buf;
+    result_bind[1].buffer_length = sizeof(idemp_key_buf);
+    result_bind[1].length = &length[1];
+    result_bind[1].is_null = &is_null[1];
 
     // paypal_order_id
-    result_bind[6].buffer_type = MYSQL_TYPE_STRING;
-    result_bind[6].buffer = paypal_order_buf;
-    result_bind[6].buffer_length = sizeof(paypal_order_buf);
-    result_bind[6].is_null = &is_null[6];
-
-    // status
-    result_bind[7].buffer_type = MYSQL_TYPE_STRING;
-    result_bind[7].buffer = status_buf;
-    result_bind[7].buffer_length = sizeof(status_buf);
-    result_bind[7].is_null = &is_null[7];
+    result_bind[2].buffer_type = MYSQL_TYPE_STRING;
+    result_bind[2].buffer = paypal_order_buf;
+    result_bind[2].buffer_length = sizeof(paypal_order_buf);
+    result_bind[2].length = &length[2];
+    result_bind[2].is_null = &is_null[2];
 
     if (mysql_stmt_bind_result(stmt, result_bind) != 0)
     {
@@ -197,49 +164,32 @@ std::pair<std::optional<std::vector<PaymentAttempt>>, Errors> PaymentAttempModel
         return {std::nullopt, Errors::BindResultFailed};
     }
 
-    if (mysql_stmt_store_result(stmt) != 0)
+    int fetch_result = mysql_stmt_fetch(stmt);
+    if (fetch_result == MYSQL_NO_DATA)
     {
-        std::cerr << "Failed to store result: " << mysql_stmt_error(stmt) << std::endl;
-        return {std::nullopt, Errors::StoreResultFailed};
+        return {std::nullopt, Errors::NoRowsFound};
     }
-
-    if (mysql_stmt_num_rows(stmt) == 0)
-    {
-        // No data
-        return {std::vector<PaymentAttempt>{}, Errors::NoError};
-    }
-
-    std::vector<PaymentAttempt> attempts;
-    while (true)
+    if (fetch_result != 0)
     {
-        int fetch_result = mysql_stmt_fetch(stmt);
-        if (fetch_result == MYSQL_NO_DATA)
-            break;
-        if (fetch_result != 0)
-        {
-            std::cerr << "Fetch error: " << mysql_stmt_error(stmt) << std::endl;
-            return {std::nullopt, Errors::FetchFailed};
-        }
-        PaymentAttempt p;
-        p.id = id;
-        p.user_id = user_id_buf;
-        p.order_id = order_id_buf;
-        p.cart_hash = std::string(cart_hash_buf, sizeof(cart_hash_buf));
-        p.total = total;
-        p.idempotency_key = std::string(idemp_key_buf, sizeof(idemp_key_buf));
-        p.paypal_order_id = std::string(paypal_order_buf, sizeof(paypal_order_buf));
-        p.status = std::string(status_buf, sizeof(status_buf));
-        attempts.push_back(std::move(p));
+        std::cerr << "Fetch error: " << mysql_stmt_error(stmt) << std::endl;
+        return {std::nullopt, Errors::FetchFailed};
     }
 
-    return {attempts, Errors::NoError};
+    PaymentAttempt attempt;
+    attempt.id = id;
+    attempt.order_id = order_id;
+    attempt.cart_hash = cart_hash;
+    attempt.idempotency_key = is_null[1] ? "" : std::string(idemp_key_buf, length[1]);
+    attempt.paypal_order_id = is_null[2] ? "" : std::string(paypal_order_buf, length[2]);
+    attempt.status = "PAYER_ACTION_REQUIRED";
+    return {attempt, Errors::NoError};
 }
 
 std::pair<bool, Errors> PaymentAttempModel::updatePaymentAttemptStatus(std::string &paypal_order_id, int order_id, int user_id, const std::string &status)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
         std::cerr << "Failed to get database connection" << std::endl;
         return std::make_pair(false, Errors::DatabaseConnectionFailed);
@@ -255,19 +205,11 @@ std::pair<bool, Errors> PaymentAttempModel::updatePaymentAttemptStatus(std::stri
 
         const char *query = "UPDATE payment_attempts SET status = ? WHERE paypal_order_id = ? AND order_id = ? AND user_id = ? ";
 
-        MYSQL_STMT *stmt = mysql_stmt_init(conn);
+        auto stmt_guard = db.prepare(query);
+        MYSQL_STMT *stmt = stmt_guard.get();
         if (!stmt)
         {
-            std::cerr << "Failed to initialize statement" << std::endl;
-            mysql_query(conn, "ROLLBACK");
-            return std::make_pair(false, Errors::StatementInitFailed);
-        }
-
-        auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-        if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-        {
-            std::cerr << "Failed to prepare statement: " << mysql_stmt_error(stmt) << std::endl;
+            std::cerr << "Failed to prepare statement: " << stmt_guard.error() << std::endl;
             mysql_query(conn, "ROLLBACK");
             return std::make_pair(false, Errors::StatementPrepareFailed);
         }
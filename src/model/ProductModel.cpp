@@ -2,6 +2,8 @@
 #include "db/DatabaseConnection.h"
 #include <mysql/mysql.h>
 #include "db/DatabaseInitializer.h"
+#include "services/ProductCatalogCache.h"
+#include "services/ReferenceDataCache.h"
 #include <iostream> // Para manejo de errores o logs, si es necesario
 #include <memory>   // Para std::unique_ptr
 #include <cstring>  // Para strlen
@@ -11,30 +13,22 @@ ProductModel::ProductModel() {} // Constructor predeterminado
 std::optional<std::vector<Product>> ProductModel::getAllProducts()
 {
 
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection (Singleton): " << mysql_error(conn) << std::endl;
+        std::cerr << "Error: No active database connection" << std::endl;
         return std::nullopt;
     }
 
     std::vector<Product> products;
     const char *query = "SELECT id, sku, name, description, price, image_url, category_id FROM products";
 
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Statement initialization failed: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-
-    // Utilizamos RAII para garantizar que se cierre el statement
-    auto stmt_guard = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>(stmt, mysql_stmt_close);
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Statement preparation failed: " << mysql_stmt_error(stmt) << std::endl;
+        std::cerr << "Statement preparation failed: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
 
@@ -137,12 +131,12 @@ bool ProductModel::insertSampleProducts()
         "('Cristales'),"
         "('Kits de Ritual');"};
 
-    // Obtenemos la instancia única de DatabaseConnection usando getInstance()
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    // Pedimos una conexión prestada al pool
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0)
+    if (!conn)
     {
-        std::cerr << "Error: No active database connection (Singleton): " << mysql_error(conn) << std::endl;
+        std::cerr << "Error: No active database connection" << std::endl;
         return false;
     }
     DatabaseInitializer dbInitializer;
@@ -154,6 +148,7 @@ bool ProductModel::insertSampleProducts()
             return false;
         }
     }
+    ReferenceDataCache::categories().invalidate();
 
     // Insert BRANDS
     std::vector<std::string> brandQueries = {
@@ -206,6 +201,9 @@ bool ProductModel::insertSampleProducts()
         }
     }
 
+    // El catálogo cambió: la próxima lectura de /products recarga la caché
+    ProductCatalogCache::getInstance().invalidate();
+
     // Insertar inventario aleatorio entre 5 y 25 por producto
     std::string inventoryInsert =
         "INSERT INTO inventory (product_id, quantity) "
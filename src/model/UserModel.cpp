@@ -11,7 +11,7 @@ std::optional<int> UserModel::createUser(const std::string &first_name,
                                          const std::string &auth_provider,
                                          const std::string &auth_id)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -20,10 +20,11 @@ std::optional<int> UserModel::createUser(const std::string &first_name,
     }
 
     const char *query = "INSERT INTO users (first_name, password, email, auth_provider, auth_id) VALUES (?, ?, ?, ?, ?)";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
-    if (!stmt || mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
     {
-        std::cerr << "Statement error: " << mysql_stmt_error(stmt) << std::endl;
+        std::cerr << "Statement error: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
 
@@ -53,18 +54,16 @@ std::optional<int> UserModel::createUser(const std::string &first_name,
     if (mysql_stmt_bind_param(stmt, bind) != 0 || mysql_stmt_execute(stmt) != 0)
     {
         std::cerr << "Execution failed: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
     int user_id = mysql_insert_id(conn);
-    mysql_stmt_close(stmt);
     return user_id;
 }
 
 std::optional<User> UserModel::findUserById(int user_id)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -73,17 +72,11 @@ std::optional<User> UserModel::findUserById(int user_id)
     }
 
     const char *query = "SELECT * FROM users WHERE id = ?";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Error: Falló la inicialización del statement: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Error: Falló la preparación del statement: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
+        std::cerr << "Error: Falló la preparación del statement: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
 
@@ -98,14 +91,12 @@ std::optional<User> UserModel::findUserById(int user_id)
     if (mysql_stmt_bind_param(stmt, param) != 0)
     {
         std::cerr << "Error: Falló al vincular el parámetro: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
     if (mysql_stmt_execute(stmt) != 0)
     {
         std::cerr << "Error: Falló la ejecución: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -134,7 +125,6 @@ std::optional<User> UserModel::findUserById(int user_id)
     if (mysql_stmt_bind_result(stmt, result) != 0)
     {
         std::cerr << "Error: Falló al vincular el resultado: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -142,14 +132,12 @@ std::optional<User> UserModel::findUserById(int user_id)
     if (mysql_stmt_store_result(stmt) != 0)
     {
         std::cerr << "Error: Falló al almacenar el resultado: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
     // Obtener el primer (y único) registro
     if (mysql_stmt_fetch(stmt) != 0)
     {
-        mysql_stmt_close(stmt);
         return std::nullopt; // No se encontró el usuario o se produjo un error
     }
 
@@ -159,13 +147,12 @@ std::optional<User> UserModel::findUserById(int user_id)
     user.first_name = std::string(first_name, first_name_len);
     user.email = std::string(email, email_len);
 
-    mysql_stmt_close(stmt);
     return user;
 }
 
 std::optional<User> UserModel::findUserByEmail(const std::string &email)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -174,17 +161,11 @@ std::optional<User> UserModel::findUserByEmail(const std::string &email)
     }
 
     const char *query = "SELECT id, first_name, email, password, auth_provider, auth_id, created_at FROM users WHERE email = ?";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
     if (!stmt)
     {
-        std::cerr << "Error: Falló la inicialización del statement: " << mysql_error(conn) << std::endl;
-        return std::nullopt;
-    }
-
-    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
-    {
-        std::cerr << "Error: Falló la preparación del statement: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
+        std::cerr << "Error: Falló la preparación del statement: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
 
@@ -199,14 +180,12 @@ std::optional<User> UserModel::findUserByEmail(const std::string &email)
     if (mysql_stmt_bind_param(stmt, param) != 0)
     {
         std::cerr << "Error: Falló al vincular el parámetro: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
     if (mysql_stmt_execute(stmt) != 0)
     {
         std::cerr << "Error: Falló la ejecución: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -266,20 +245,17 @@ std::optional<User> UserModel::findUserByEmail(const std::string &email)
     if (mysql_stmt_bind_result(stmt, result) != 0)
     {
         std::cerr << "Error: Falló al vincular el resultado: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
     if (mysql_stmt_store_result(stmt) != 0)
     {
         std::cerr << "Error: Falló al almacenar el resultado: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
     if (mysql_stmt_fetch(stmt) != 0)
     {
-        mysql_stmt_close(stmt);
         return std::nullopt; // No se encontró el usuario o se produjo un error
     }
 
@@ -293,13 +269,12 @@ std::optional<User> UserModel::findUserByEmail(const std::string &email)
     user.auth_id = std::string(auth_id, auth_id_len);
     user.created_at = std::string(created_at, created_at_len);
 
-    mysql_stmt_close(stmt);
     return user;
 }
 
 std::optional<User> UserModel::findUserByEmailAndProvider(const std::string &email, const std::string &auth_provider)
 {
-    DatabaseConnection &db = DatabaseConnection::getInstance();
+    auto db = ConnectionPool::getInstance().acquire();
     MYSQL *conn = db.getConnection();
     if (!conn)
     {
@@ -308,10 +283,11 @@ std::optional<User> UserModel::findUserByEmailAndProvider(const std::string &ema
     }
 
     const char *query = "SELECT id, first_name, email, password, auth_provider, auth_id, created_at FROM users WHERE email = ? AND auth_provider = ?";
-    MYSQL_STMT *stmt = mysql_stmt_init(conn);
-    if (!stmt || mysql_stmt_prepare(stmt, query, strlen(query)) != 0)
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
     {
-        std::cerr << "Statement error: " << mysql_stmt_error(stmt) << std::endl;
+        std::cerr << "Statement error: " << stmt_guard.error() << std::endl;
         return std::nullopt;
     }
 
@@ -329,7 +305,6 @@ std::optional<User> UserModel::findUserByEmailAndProvider(const std::string &ema
     if (mysql_stmt_bind_param(stmt, param) != 0 || mysql_stmt_execute(stmt) != 0)
     {
         std::cerr << "Param bind or execute error: " << mysql_stmt_error(stmt) << std::endl;
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -376,7 +351,6 @@ std::optional<User> UserModel::findUserByEmailAndProvider(const std::string &ema
 
     if (mysql_stmt_bind_result(stmt, result) != 0 || mysql_stmt_store_result(stmt) != 0 || mysql_stmt_fetch(stmt) != 0)
     {
-        mysql_stmt_close(stmt);
         return std::nullopt;
     }
 
@@ -389,6 +363,43 @@ std::optional<User> UserModel::findUserByEmailAndProvider(const std::string &ema
     user.auth_id = std::string(auth_id, auth_id_len);
     user.created_at = std::string(created_at, created_at_len);
 
-    mysql_stmt_close(stmt);
     return user;
-}
\ No newline at end of file
+}
+
+bool UserModel::updatePassword(int user_id, const std::string &password)
+{
+    auto db = ConnectionPool::getInstance().acquire();
+    MYSQL *conn = db.getConnection();
+    if (!conn)
+    {
+        std::cerr << "Error: No DB connection" << std::endl;
+        return false;
+    }
+
+    const char *query = "UPDATE users SET password = ? WHERE id = ? AND auth_provider = 'local'";
+    auto stmt_guard = db.prepare(query);
+    MYSQL_STMT *stmt = stmt_guard.get();
+    if (!stmt)
+    {
+        std::cerr << "Statement error: " << stmt_guard.error() << std::endl;
+        return false;
+    }
+
+    MYSQL_BIND bind[2];
+    memset(bind, 0, sizeof(bind));
+
+    bind[0].buffer_type = MYSQL_TYPE_STRING;
+    bind[0].buffer = (void *)password.c_str();
+    bind[0].buffer_length = password.length();
+
+    bind[1].buffer_type = MYSQL_TYPE_LONG;
+    bind[1].buffer = (void *)&user_id;
+
+    if (mysql_stmt_bind_param(stmt, bind) != 0 || mysql_stmt_execute(stmt) != 0)
+    {
+        std::cerr << "Execution failed: " << mysql_stmt_error(stmt) << std::endl;
+        return false;
+    }
+
+    return mysql_stmt_affected_rows(stmt) > 0;
+}
@@ -0,0 +1,182 @@
+#include "router/RouteTable.h"
+#include <charconv>
+#include <stdexcept>
+
+struct RouteTable::Node
+{
+    std::vector<std::pair<utility::string_t, std::unique_ptr<Node>>> statics;
+    std::unique_ptr<Node> param;
+    bool paramIsInt = false;
+    std::array<std::optional<Route>, static_cast<size_t>(Method::Count)> routes;
+};
+
+namespace
+{
+    // Separa el primer segmento de `rest` y avanza `rest` hasta el siguiente '/'
+    PathSegment nextSegment(PathSegment &rest)
+    {
+        while (!rest.empty() && rest.front() == '/')
+            rest.remove_prefix(1);
+
+        size_t end = rest.find('/');
+        PathSegment segment = rest.substr(0, end);
+        rest.remove_prefix(end == PathSegment::npos ? rest.size() : end);
+        return segment;
+    }
+
+    bool isInteger(PathSegment segment)
+    {
+        if (segment.empty() || segment.size() > 9)
+            return false;
+        for (auto c : segment)
+        {
+            if (c < '0' || c > '9')
+                return false;
+        }
+        return true;
+    }
+}
+
+//---------- ROUTE PARAMS ----------
+
+void RouteParams::push(PathSegment value)
+{
+    if (count_ >= kMaxParams)
+        throw std::length_error("RouteParams: demasiados parámetros en la ruta");
+    values_[count_++] = value;
+}
+
+PathSegment RouteParams::raw(size_t index) const
+{
+    return index < count_ ? values_[index] : PathSegment{};
+}
+
+std::optional<int> RouteParams::getInt(size_t index) const
+{
+    PathSegment value = raw(index);
+    int result = 0;
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (value.empty() || ec != std::errc() || ptr != value.data() + value.size())
+        return std::nullopt;
+    return result;
+}
+
+utility::string_t RouteParams::getString(size_t index) const
+{
+    PathSegment value = raw(index);
+    return utility::string_t(value.data(), value.size());
+}
+
+//---------- ROUTE TABLE ----------
+
+RouteTable::RouteTable() : root_(std::make_unique<Node>()) {}
+
+RouteTable::~RouteTable() = default;
+
+std::optional<RouteTable::Method> RouteTable::toMethod(const web::http::method &method)
+{
+    if (method == web::http::methods::GET)
+        return Method::Get;
+    if (method == web::http::methods::POST)
+        return Method::Post;
+    if (method == web::http::methods::PUT)
+        return Method::Put;
+    if (method == web::http::methods::DEL)
+        return Method::Delete;
+    if (method == web::http::methods::PATCH)
+        return Method::Patch;
+    return std::nullopt;
+}
+
+void RouteTable::add(const web::http::method &method, const utility::string_t &pattern, Route route)
+{
+    auto routeMethod = toMethod(method);
+    if (!routeMethod.has_value())
+        throw std::invalid_argument("RouteTable: método HTTP no soportado");
+
+    Node *node = root_.get();
+    PathSegment rest(pattern);
+    while (true)
+    {
+        PathSegment segment = nextSegment(rest);
+        if (segment.empty())
+            break;
+
+        if (segment.front() == '{' && segment.back() == '}')
+        {
+            bool isInt = segment.find(U(":int")) != PathSegment::npos;
+            if (!node->param)
+            {
+                node->param = std::make_unique<Node>();
+                node->paramIsInt = isInt;
+            }
+            else if (node->paramIsInt != isInt)
+            {
+                throw std::invalid_argument("RouteTable: parámetros con tipos distintos en la misma posición");
+            }
+            node = node->param.get();
+            continue;
+        }
+
+        Node *child = nullptr;
+        for (auto &[key, next] : node->statics)
+        {
+            if (PathSegment(key) == segment)
+            {
+                child = next.get();
+                break;
+            }
+        }
+        if (!child)
+        {
+            node->statics.emplace_back(utility::string_t(segment), std::make_unique<Node>());
+            child = node->statics.back().second.get();
+        }
+        node = child;
+    }
+
+    auto &slot = node->routes[static_cast<size_t>(routeMethod.value())];
+    if (slot.has_value())
+        throw std::invalid_argument("RouteTable: ruta duplicada " + utility::conversions::to_utf8string(pattern));
+    slot = std::move(route);
+}
+
+const Route *RouteTable::match(const web::http::method &method, PathSegment path, RouteParams &params) const
+{
+    auto routeMethod = toMethod(method);
+    if (!routeMethod.has_value())
+        return nullptr;
+    return matchNode(*root_, routeMethod.value(), path, params);
+}
+
+const Route *RouteTable::matchNode(const Node &node, Method method, PathSegment rest, RouteParams &params) const
+{
+    PathSegment segment = nextSegment(rest);
+    if (segment.empty())
+    {
+        const auto &slot = node.routes[static_cast<size_t>(method)];
+        return slot.has_value() ? &slot.value() : nullptr;
+    }
+
+    // Los segmentos estáticos tienen prioridad (/address/default/... frente a /address/{type}/...)
+    for (const auto &[key, next] : node.statics)
+    {
+        if (PathSegment(key) == segment)
+        {
+            if (const Route *route = matchNode(*next, method, rest, params))
+                return route;
+            break;
+        }
+    }
+
+    if (node.param && (!node.paramIsInt || isInteger(segment)) && params.size() < RouteParams::kMaxParams)
+    {
+        size_t mark = params.size();
+        params.push(segment);
+        if (const Route *route = matchNode(*node.param, method, rest, params))
+            return route;
+        params.truncate(mark);
+    }
+
+    return nullptr;
+}
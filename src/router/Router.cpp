@@ -12,6 +12,8 @@ Router::Router(web::http::experimental::listener::http_listener &listener)
 
 void Router::setup_routes()
 {
+    register_routes();
+
     // Manejo de preflight (CORS)
     listener_.support(web::http::methods::OPTIONS, [](const web::http::http_request &request)
                       {
@@ -19,110 +21,14 @@ void Router::setup_routes()
         Server::add_cors_headers(response);
         request.reply(response); });
 
-    // Manejo general en hilo separado
+    // Manejo general en hilo separado; la respuesta se envía al completarse la tarea
     listener_.support([this](const web::http::http_request &request)
-                      { pplx::create_task([=]()
-                                          {
+                      { pplx::create_task([this, request]()
+                                          { return dispatch(request); })
+                            .then([request](pplx::task<web::http::http_response> task)
+                                  {
             try {
-                auto path = request.relative_uri().path();
-                auto method = request.method();
-                web::http::http_response response(status_codes::NotFound);
-                response.set_body(U("Ruta no encontrada"));
-
-                // USERS
-                if (method == web::http::methods::POST && path == U("/signup"))
-                    response = authController.signup(request);
-                else if (method == web::http::methods::POST && path == U("/login"))
-                    response = authController.login(request);
-                else if (method == web::http::methods::POST && path == U("/auth-google"))
-                    response = authController.googleLogin(request);
-
-                // PRODUCTS
-                else if (method == web::http::methods::GET && path == U("/products")) {
-                    ProductController model;
-                    response = model.getAllProducts();
-                }
-
-                // SHIPPING ADDRESS
-                auto segments_addresses = web::uri::split_path(request.request_uri().path());
-                if (path.find(U("/address")) != std::string::npos) {
-                    auto userOpt = AuthMiddleware::authenticateRequest(request);
-                    if (!userOpt.has_value()) {
-                        response.set_status_code(status_codes::Unauthorized);
-                        response.set_body(json::value::object({ {U("error"), json::value::string(U("No autorizado"))} }));
-                    } else {
-                        DecodedUser user = userOpt.value();
-                        if (method == web::http::methods::GET && path == U("/address"))
-                            response = addressController.getAddressesByUserId(request, user.id);
-                        else if (method == web::http::methods::GET)
-                            response = addressController.getAddressById(request, user.id);
-                        else if (method == web::http::methods::POST)
-                            response = addressController.createAddress(request, user.id);
-                        else if (method == web::http::methods::PUT && path.find(U("default")) != std::string::npos)
-                            response = addressController.setDefaultAddressController(request, user.id);
-                        else if (method == web::http::methods::PUT)
-                            response = addressController.updateAddress(request, user.id);
-                        else if (method == web::http::methods::DEL)
-                            response = addressController.deleteAddress(request, user.id);
-                    }
-                }
-
-                // ORDERS
-                else if (path.find(U("/order")) != std::string::npos) {
-                    auto userOpt = AuthMiddleware::authenticateRequest(request);
-                    if (!userOpt.has_value()) {
-                        response.set_status_code(status_codes::Unauthorized);
-                        response.set_body(json::value::object({ {U("error"), json::value::string(U("No autorizado"))} }));
-                    } else {
-                        DecodedUser user = userOpt.value();
-                        if (method == web::http::methods::POST && path == U("/order"))
-                            response = orderController.createOrder(request, user.id);
-                        else if (method == web::http::methods::GET && path == U("/order"))
-                            response = orderController.getOrdersByUserId(request, user.id);
-                        else if (method == web::http::methods::GET)
-                            response = orderController.getOrderById(request, user.id);
-                        else if (method == web::http::methods::PUT) {
-                            auto path_segments = web::uri::split_path(request.request_uri().path());
-                            if (path_segments.size() == 4 &&
-                                path_segments[0] == U("order") &&
-                                path_segments[2] == U("carrier")) {
-                                response = orderController.updateTotalbyOrderId(request, user.id);
-                            }
-                        }
-                    }
-                }
-
-                // PAYPAL
-                auto segments = web::uri::split_path(request.request_uri().path());
-                if ((method == methods::POST) &&
-                    ((segments.size() == 3 || segments.size() == 4) && segments[0] == U("paypal"))) {
-                    auto userOpt = AuthMiddleware::authenticateRequest(request);
-                    if (!userOpt.has_value()) {
-                        response.set_status_code(status_codes::Unauthorized);
-                        response.set_body(json::value::object({ {U("error"), json::value::string(U("No autorizado"))} }));
-                    } else {
-                        DecodedUser user = userOpt.value();
-                        PaypalController paypalController;
-                        if (segments[2] == U("create"))
-                            response = paypalController.createPayment(request, user.id);
-                        else if (segments[2] == U("capture"))
-                            response = paypalController.capturePayment(request, user.id);
-                        else
-                            response = http_response(status_codes::NotFound);
-                    }
-                }
-
-                // CARRIERS
-                else if (method == web::http::methods::GET && path == U("/carriers")) {
-                    CarrierController model;
-                    response = model.getCarriers(request);
-                }
-
-                // CATEGORIES
-                else if (method == web::http::methods::GET && path == U("/categories")) {
-                    CategoryController categoryController;
-                    response = categoryController.getAllCategories();
-                }
+                web::http::http_response response = task.get();
 
                 // Añadir headers CORS SIEMPRE
                 Server::add_cors_headers(response);
@@ -143,3 +49,109 @@ void Router::setup_routes()
                 request.reply(errorResponse);
             } }); });
 }
+
+void Router::register_routes()
+{
+    using web::http::methods;
+    const bool PUBLIC = false;
+    const bool PRIVATE = true;
+
+    // USERS
+    routes_.add(methods::POST, U("/signup"), {PUBLIC, nullptr, [](const http_request &request, const RouteParams &, const DecodedUser &)
+                                              { return authController.signup(request); }});
+    routes_.add(methods::POST, U("/login"), {PUBLIC, nullptr, [](const http_request &request, const RouteParams &, const DecodedUser &)
+                                             { return authController.login(request); }});
+    routes_.add(methods::POST, U("/auth-google"), {PUBLIC, [](const http_request &request, const RouteParams &, const DecodedUser &)
+                                                   { return authController.googleLogin(request); }});
+
+    // PRODUCTS
+    routes_.add(methods::GET, U("/products"), {PUBLIC, [](const http_request &, const RouteParams &, const DecodedUser &)
+                                               {
+                                                   ProductController controller;
+                                                   return controller.getAllProducts();
+                                               }});
+
+    // SHIPPING ADDRESS
+    routes_.add(methods::GET, U("/address"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                              { return addressController.getAddressesByUserId(request, user.id); }});
+    routes_.add(methods::GET, U("/address/{id}"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                                       { return addressController.getAddressById(request, user.id); }});
+    routes_.add(methods::POST, U("/address"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                               { return addressController.createAddress(request, user.id); }});
+    routes_.add(methods::PUT, U("/address/default/{type}/{id}"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                                                      { return addressController.setDefaultAddressController(request, user.id); }});
+    routes_.add(methods::PUT, U("/address/{id}"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                                       { return addressController.updateAddress(request, user.id); }});
+    routes_.add(methods::PUT, U("/address/{type}/{id}"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                                              { return addressController.updateAddress(request, user.id); }});
+    routes_.add(methods::DEL, U("/address/{id}"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                                       { return addressController.deleteAddress(request, user.id); }});
+
+    // ORDERS
+    routes_.add(methods::POST, U("/order"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                             { return orderController.createOrder(request, user.id); }});
+    routes_.add(methods::GET, U("/order"), {PRIVATE, [](const http_request &request, const RouteParams &, const DecodedUser &user)
+                                            { return orderController.getOrdersByUserId(request, user.id); }});
+    routes_.add(methods::GET, U("/order/{id:int}"), {PRIVATE, [](const http_request &request, const RouteParams &params, const DecodedUser &user)
+                                                     { return orderController.getOrderById(request, user.id, params.getInt(0).value()); }});
+    routes_.add(methods::PUT, U("/order/{id:int}/carrier/{id:int}"), {PRIVATE, [](const http_request &request, const RouteParams &params, const DecodedUser &user)
+                                                                      { return orderController.updateTotalbyOrderId(request, user.id, params.getInt(0).value(), params.getInt(1).value()); }});
+
+    // PAYPAL
+    routes_.add(methods::POST, U("/paypal/{id:int}/create"), {PRIVATE, nullptr, [](const http_request &request, const RouteParams &params, const DecodedUser &user)
+                                                              {
+                                                                  PaypalController paypalController;
+                                                                  return paypalController.createPayment(request, user.id, params.getInt(0).value());
+                                                              }});
+    routes_.add(methods::POST, U("/paypal/{paypalOrderId}/capture/{orderId:int}"), {PRIVATE, nullptr, [](const http_request &request, const RouteParams &params, const DecodedUser &user)
+                                                                                   {
+                                                                                       PaypalController paypalController;
+                                                                                       return paypalController.capturePayment(request, user.id, params.getString(0), params.getInt(1).value());
+                                                                                   }});
+
+    // CARRIERS
+    routes_.add(methods::GET, U("/carriers"), {PUBLIC, [](const http_request &request, const RouteParams &, const DecodedUser &)
+                                               {
+                                                   CarrierController controller;
+                                                   return controller.getCarriers(request);
+                                               }});
+
+    // CATEGORIES
+    routes_.add(methods::GET, U("/categories"), {PUBLIC, [](const http_request &request, const RouteParams &, const DecodedUser &)
+                                                 {
+                                                     CategoryController categoryController;
+                                                     return categoryController.getAllCategories(request);
+                                                 }});
+}
+
+pplx::task<web::http::http_response> Router::dispatch(const web::http::http_request &request) const
+{
+    const auto path = request.relative_uri().path();
+    RouteParams params;
+    const Route *route = routes_.match(request.method(), path, params);
+    if (!route)
+    {
+        web::http::http_response response(status_codes::NotFound);
+        response.set_body(U("Ruta no encontrada"));
+        return pplx::task_from_result(response);
+    }
+
+    DecodedUser user{};
+    if (route->requiresAuth)
+    {
+        auto userOpt = AuthMiddleware::authenticateRequest(request);
+        if (!userOpt.has_value())
+        {
+            web::http::http_response response(status_codes::Unauthorized);
+            response.set_body(json::value::object({{U("error"), json::value::string(U("No autorizado"))}}));
+            return pplx::task_from_result(response);
+        }
+        user = userOpt.value();
+    }
+
+    if (route->asyncHandler)
+    {
+        return route->asyncHandler(request, params, user);
+    }
+    return pplx::task_from_result(route->handler(request, params, user));
+}
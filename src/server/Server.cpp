@@ -1,6 +1,6 @@
 #include "server/Server.h"
 #include "router/Router.h"
-#include "db/DatabaseConnection.h" // Incluimos el Singleton
+#include "db/DatabaseConnection.h"
 #include <iostream>
 
 Server::Server(const utility::string_t &address) : listener_(address), router_(listener_) {};
@@ -0,0 +1,194 @@
+#include "services/PasswordHasher.h"
+#include <algorithm>
+#include <iostream>
+#include <sodium.h>
+#include "env/Config.h"
+
+//---------- LATENCY HISTOGRAM ----------
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration elapsed)
+{
+    auto ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    size_t bucket = std::lower_bound(kBoundsMs.begin(), kBoundsMs.end(), ms) - kBoundsMs.begin();
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::array<uint64_t, LatencyHistogram::kBoundsMs.size() + 1> LatencyHistogram::counts() const
+{
+    std::array<uint64_t, kBoundsMs.size() + 1> result{};
+    for (size_t i = 0; i < buckets_.size(); ++i)
+        result[i] = buckets_[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+//---------- PASSWORD HASHER ----------
+
+PasswordHasher &PasswordHasher::getInstance()
+{
+    static PasswordHasher instance = []()
+    {
+        const Config &config = Config::get();
+        HashParams params = resolveProfile(config.passwordHashProfile,
+                                           config.passwordHashOpsLimit,
+                                           config.passwordHashMemLimitMb * 1024 * 1024,
+                                           config.passwordHashTargetVerify);
+        std::cout << "[PasswordHasher] Perfil " << config.passwordHashProfile << ": opslimit=" << params.opsLimit
+                  << " memlimit=" << params.memLimit / (1024 * 1024) << " MiB" << std::endl;
+        return PasswordHasher(config.passwordHashWorkers,
+                              config.passwordHashQueueMax,
+                              config.passwordHashMemoryBudgetMb * 1024 * 1024,
+                              params);
+    }();
+    return instance;
+}
+
+HashParams PasswordHasher::resolveProfile(const std::string &profile, unsigned long long opsLimit,
+                                          size_t memLimit, std::chrono::milliseconds target)
+{
+    if (profile == "interactive")
+        return {crypto_pwhash_OPSLIMIT_INTERACTIVE, crypto_pwhash_MEMLIMIT_INTERACTIVE};
+    if (profile == "sensitive")
+        return {crypto_pwhash_OPSLIMIT_SENSITIVE, crypto_pwhash_MEMLIMIT_SENSITIVE};
+    if (profile == "custom")
+        return {std::max<unsigned long long>(opsLimit, crypto_pwhash_OPSLIMIT_MIN),
+                std::max<size_t>(memLimit, crypto_pwhash_MEMLIMIT_MIN)};
+    if (profile == "auto")
+        return calibrate(std::max<size_t>(memLimit, crypto_pwhash_MEMLIMIT_MIN), target);
+    if (profile != "moderate")
+        std::cerr << "[PasswordHasher] Perfil desconocido '" << profile << "'. Usando moderate." << std::endl;
+    return {crypto_pwhash_OPSLIMIT_MODERATE, crypto_pwhash_MEMLIMIT_MODERATE};
+}
+
+HashParams PasswordHasher::calibrate(size_t memLimit, std::chrono::milliseconds target)
+{
+    static const std::string sample = "calibracion-argon2";
+    HashParams params{crypto_pwhash_OPSLIMIT_MIN, memLimit};
+    char hashed[crypto_pwhash_STRBYTES];
+
+    // Unas pocas rondas: el tiempo crece casi lineal con opslimit
+    for (int round = 0; round < 8; ++round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (crypto_pwhash_str(hashed, sample.c_str(), sample.size(), params.opsLimit, params.memLimit) != 0)
+        {
+            std::cerr << "[PasswordHasher] Calibración fallida. Usando moderate." << std::endl;
+            return {crypto_pwhash_OPSLIMIT_MODERATE, crypto_pwhash_MEMLIMIT_MODERATE};
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        if (elapsed >= target)
+            break;
+
+        unsigned long long estimate = elapsed.count() > 0
+                                          ? params.opsLimit * target.count() / elapsed.count()
+                                          : params.opsLimit * 2;
+        params.opsLimit = std::min<unsigned long long>(std::max(estimate, params.opsLimit + 1), 64);
+    }
+    return params;
+}
+
+PasswordHasher::PasswordHasher(size_t workers, size_t maxQueue, size_t memoryBudgetBytes, HashParams params)
+    : maxQueue_(maxQueue), params_(params)
+{
+    // Cada operación Argon2 reserva memLimit bytes: no más hilos de los que caben en el presupuesto
+    size_t byMemory = std::max<size_t>(1, memoryBudgetBytes / params_.memLimit);
+    size_t count = std::max<size_t>(1, std::min(workers, byMemory));
+    if (count < workers)
+        std::cerr << "[PasswordHasher] Presupuesto de memoria limita los hilos a " << count << std::endl;
+
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        workers_.emplace_back([this]()
+                              { run(); });
+}
+
+PasswordHasher::~PasswordHasher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    available_.notify_all();
+    for (auto &worker : workers_)
+        worker.join();
+}
+
+bool PasswordHasher::submit(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= maxQueue_)
+        {
+            ++rejected_;
+            return false;
+        }
+        queue_.push_back(std::move(job));
+    }
+    available_.notify_one();
+    return true;
+}
+
+void PasswordHasher::run()
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            available_.wait(lock, [this]()
+                            { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+                return;
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        job();
+    }
+}
+
+std::optional<pplx::task<std::optional<std::string>>> PasswordHasher::hash(std::string password)
+{
+    pplx::task_completion_event<std::optional<std::string>> done;
+    bool accepted = submit([this, done, password = std::move(password)]()
+                           {
+        auto start = std::chrono::steady_clock::now();
+        char hashed[crypto_pwhash_STRBYTES];
+        bool ok = crypto_pwhash_str(hashed, password.c_str(), password.size(),
+                                    params_.opsLimit, params_.memLimit) == 0;
+        hashLatency_.record(std::chrono::steady_clock::now() - start);
+        done.set(ok ? std::optional<std::string>(hashed) : std::nullopt); });
+    if (!accepted)
+        return std::nullopt;
+    return pplx::create_task(done);
+}
+
+std::optional<pplx::task<VerifyResult>> PasswordHasher::verify(std::string storedHash, std::string password)
+{
+    pplx::task_completion_event<VerifyResult> done;
+    bool accepted = submit([this, done, storedHash = std::move(storedHash), password = std::move(password)]()
+                           {
+        auto start = std::chrono::steady_clock::now();
+        VerifyResult result;
+        result.matches = crypto_pwhash_str_verify(storedHash.c_str(), password.c_str(), password.size()) == 0;
+        verifyLatency_.record(std::chrono::steady_clock::now() - start);
+        if (result.matches)
+            result.needsRehash = crypto_pwhash_str_needs_rehash(storedHash.c_str(), params_.opsLimit, params_.memLimit) != 0;
+        done.set(result); });
+    if (!accepted)
+        return std::nullopt;
+    return pplx::create_task(done);
+}
+
+PasswordHasher::Stats PasswordHasher::stats() const
+{
+    Stats result;
+    result.workers = workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.queued = queue_.size();
+    }
+    result.rejected = rejected_.load();
+    result.hashLatency = hashLatency_.counts();
+    result.verifyLatency = verifyLatency_.counts();
+    return result;
+}
@@ -0,0 +1,83 @@
+#include "services/PaypalTokenCache.h"
+#include <algorithm>
+#include <iostream>
+#include "env/Config.h"
+#include "services/PaypalService.h"
+
+PaypalTokenCache &PaypalTokenCache::getInstance()
+{
+    static PaypalTokenCache instance(PaypalService::requestAccessToken,
+                                     Config::get().paypalTokenRefreshMargin);
+    return instance;
+}
+
+PaypalTokenCache::PaypalTokenCache(Fetcher fetcher, std::chrono::seconds refreshMargin)
+    : fetcher_(std::move(fetcher)), refreshMargin_(refreshMargin) {}
+
+pplx::task<std::string> PaypalTokenCache::get()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+
+    if (!token_.empty() && now < expiresAt_)
+    {
+        // Cerca de caducar: se renueva en segundo plano y se sirve el actual
+        if (now >= expiresAt_ - refreshMargin_ && !inflight_)
+            startRefresh();
+        return pplx::task_from_result(token_);
+    }
+
+    // Sin token válido: todas las llamadas esperan a la misma petición
+    auto refresh = inflight_ ? *inflight_ : startRefresh();
+    return refresh.then([this]()
+                        { return currentToken(); });
+}
+
+void PaypalTokenCache::invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    token_.clear();
+    expiresAt_ = std::chrono::steady_clock::time_point{};
+}
+
+std::string PaypalTokenCache::currentToken()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::chrono::steady_clock::now() < expiresAt_ ? token_ : std::string();
+}
+
+pplx::task<void> PaypalTokenCache::startRefresh()
+{
+    auto refresh = pplx::create_task([this]()
+                                     { return fetcher_(); })
+                       .then([this](pplx::task<std::optional<PaypalAccessToken>> fetched)
+                             {
+        std::optional<PaypalAccessToken> token;
+        try
+        {
+            token = fetched.get();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[PaypalTokenCache] Error al pedir el token: " << e.what() << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (token.has_value() && !token->accessToken.empty())
+        {
+            auto expiresIn = token->expiresIn;
+            if (expiresIn <= std::chrono::seconds(0))
+            {
+                // Sin expires_in el token caducaría al guardarlo y cada llamada
+                // pediría otro; se asume una vida corta con margen de refresco
+                expiresIn = std::max(kFallbackExpiresIn, refreshMargin_ * 2);
+                std::cerr << "[PaypalTokenCache] Respuesta sin expires_in; se asumen "
+                          << expiresIn.count() << " s" << std::endl;
+            }
+            token_ = std::move(token->accessToken);
+            expiresAt_ = std::chrono::steady_clock::now() + expiresIn;
+        }
+        inflight_.reset(); });
+    inflight_ = refresh;
+    return refresh;
+}
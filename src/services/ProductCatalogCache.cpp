@@ -0,0 +1,76 @@
+#include "services/ProductCatalogCache.h"
+#include <iostream>
+#include "env/Config.h"
+#include "model/ProductModel.h"
+
+ProductCatalogCache &ProductCatalogCache::getInstance()
+{
+    static ProductCatalogCache instance(Config::get().productsCacheTtl);
+    return instance;
+}
+
+ProductCatalogCache::ProductCatalogCache(std::chrono::seconds ttl) : cache_(load, ttl) {}
+
+std::shared_ptr<const ProductCatalogSnapshot> ProductCatalogCache::get()
+{
+    return cache_.get();
+}
+
+void ProductCatalogCache::invalidate()
+{
+    cache_.invalidate();
+}
+
+Errors ProductCatalogCache::applyPrices(std::vector<OrderItem> &items)
+{
+    auto catalog = get();
+    if (!catalog)
+        return Errors::DatabaseConnectionFailed;
+
+    for (auto &item : items)
+    {
+        auto it = catalog->prices.find(item.product_id);
+        if (it == catalog->prices.end())
+            return Errors::NoRowsFound;
+        item.price = it->second;
+    }
+    return Errors::NoError;
+}
+
+std::optional<ProductCatalogSnapshot> ProductCatalogCache::load()
+{
+    ProductModel model;
+    auto products_opt = model.getAllProducts();
+    if (!products_opt.has_value())
+    {
+        std::cerr << "[ProductCatalogCache] Error al cargar productos" << std::endl;
+        return std::nullopt;
+    }
+
+    auto snapshot = std::make_optional<ProductCatalogSnapshot>();
+    snapshot->products = std::move(products_opt.value());
+
+    // DECIMAL(10,2) llega como double; se redondea una sola vez a céntimos
+    snapshot->prices.reserve(snapshot->products.size());
+    for (const auto &product : snapshot->products)
+        snapshot->prices.emplace(product.id, Money::fromDouble(product.price));
+
+    web::json::value result = web::json::value::array(snapshot->products.size());
+    for (size_t i = 0; i < snapshot->products.size(); ++i)
+    {
+        const auto &product = snapshot->products[i];
+        web::json::value jsonProduct;
+        jsonProduct[U("id")] = web::json::value::number(product.id);
+        jsonProduct[U("sku")] = web::json::value::string(utility::conversions::to_string_t(product.sku));
+        jsonProduct[U("name")] = web::json::value::string(utility::conversions::to_string_t(product.name));
+        jsonProduct[U("description")] = web::json::value::string(utility::conversions::to_string_t(product.description));
+        jsonProduct[U("price")] = web::json::value::number(product.price);
+        jsonProduct[U("image_url")] = web::json::value::string(utility::conversions::to_string_t(product.image_url));
+        jsonProduct[U("category_id")] = web::json::value::number(product.category_id);
+        result[i] = jsonProduct;
+    }
+    snapshot->body = result.serialize();
+
+    std::cout << "[ProductCatalogCache] Catálogo cargado: " << snapshot->products.size() << " productos" << std::endl;
+    return snapshot;
+}
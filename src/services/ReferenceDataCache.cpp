@@ -0,0 +1,137 @@
+#include "services/ReferenceDataCache.h"
+#include <iostream>
+#include <cpprest/json.h>
+#include "env/Config.h"
+#include "model/CarrierModel.h"
+#include "model/CategoryModel.h"
+#include "utils/UtilsOwner.h"
+
+namespace
+{
+    std::optional<utility::string_t> loadCarriers()
+    {
+        CarrierModel carrierModel;
+        auto [optCarriers, errors] = carrierModel.getAllCarriers();
+        if (!optCarriers.has_value())
+            return std::nullopt;
+
+        web::json::value json_response = web::json::value::array(optCarriers->size());
+        for (size_t i = 0; i < optCarriers->size(); ++i)
+        {
+            const auto &carrier = optCarriers->at(i);
+            json_response[i] = web::json::value::object();
+            json_response[i][U("id")] = web::json::value::number(carrier.id);
+            json_response[i][U("name")] = web::json::value::string(carrier.name);
+            json_response[i][U("price")] = web::json::value::number(carrier.price.toDouble());
+        }
+        return json_response.serialize();
+    }
+
+    std::optional<utility::string_t> loadCategories()
+    {
+        CategoryModel categoryModel;
+        auto [optCategories, errors] = categoryModel.getAllCategories();
+        if (!optCategories.has_value())
+            return std::nullopt;
+
+        web::json::value json_response = web::json::value::array(optCategories->size());
+        for (size_t i = 0; i < optCategories->size(); ++i)
+        {
+            const auto &category = optCategories->at(i);
+            json_response[i] = web::json::value::object();
+            json_response[i][U("id")] = web::json::value::number(category.id);
+            json_response[i][U("name")] = web::json::value::string(category.name);
+        }
+        return json_response.serialize();
+    }
+
+    utility::string_t trim(const utility::string_t &value)
+    {
+        auto begin = value.find_first_not_of(U(" \t"));
+        if (begin == utility::string_t::npos)
+            return utility::string_t();
+        auto end = value.find_last_not_of(U(" \t"));
+        return value.substr(begin, end - begin + 1);
+    }
+}
+
+ReferenceDataCache::ReferenceDataCache(Loader loader, std::chrono::seconds ttl)
+    : cacheControl_(U("public, max-age=") + utility::conversions::to_string_t(std::to_string(ttl.count()))),
+      cache_([loader = std::move(loader)]() -> std::optional<CachedBody>
+             {
+                 auto body = loader();
+                 if (!body.has_value())
+                     return std::nullopt;
+
+                 CachedBody cached;
+                 cached.body = std::move(body.value());
+                 // ETag fuerte: depende solo del contenido, así sobrevive a recargas sin cambios
+                 cached.etag = U("\"") + utility::conversions::to_string_t(UtilsOwner::sha256Hex(utility::conversions::to_utf8string(cached.body)).substr(0, 32)) + U("\"");
+                 return cached;
+             },
+             ttl) {}
+
+ReferenceDataCache &ReferenceDataCache::carriers()
+{
+    static ReferenceDataCache instance(loadCarriers, Config::get().referenceCacheTtl);
+    return instance;
+}
+
+ReferenceDataCache &ReferenceDataCache::categories()
+{
+    static ReferenceDataCache instance(loadCategories, Config::get().referenceCacheTtl);
+    return instance;
+}
+
+std::shared_ptr<const CachedBody> ReferenceDataCache::get()
+{
+    return cache_.get();
+}
+
+void ReferenceDataCache::invalidate()
+{
+    cache_.invalidate();
+}
+
+bool ReferenceDataCache::matchesEtag(const utility::string_t &ifNoneMatch, const utility::string_t &etag) const
+{
+    size_t start = 0;
+    while (start <= ifNoneMatch.size())
+    {
+        size_t comma = ifNoneMatch.find(U(','), start);
+        if (comma == utility::string_t::npos)
+            comma = ifNoneMatch.size();
+
+        utility::string_t candidate = trim(ifNoneMatch.substr(start, comma - start));
+        // If-None-Match usa comparación débil: W/"x" coincide con "x"
+        if (candidate.rfind(U("W/"), 0) == 0)
+            candidate = candidate.substr(2);
+        if (candidate == U("*") || candidate == etag)
+            return true;
+
+        start = comma + 1;
+    }
+    return false;
+}
+
+std::optional<web::http::http_response> ReferenceDataCache::respond(const web::http::http_request &request)
+{
+    auto cached = get();
+    if (!cached)
+        return std::nullopt;
+
+    web::http::http_response response;
+    response.headers().add(web::http::header_names::etag, cached->etag);
+    response.headers().add(web::http::header_names::cache_control, cacheControl_);
+
+    auto ifNoneMatch = request.headers().find(web::http::header_names::if_none_match);
+    if (ifNoneMatch != request.headers().end() && matchesEtag(ifNoneMatch->second, cached->etag))
+    {
+        response.set_status_code(web::http::status_codes::NotModified);
+        return response;
+    }
+
+    response.set_status_code(web::http::status_codes::OK);
+    response.set_body(cached->body, U("application/json"));
+    return response;
+}
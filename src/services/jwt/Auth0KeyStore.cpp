@@ -0,0 +1,182 @@
+#include "services/jwt/Auth0KeyStore.h"
+#include "services/jwt/Auth0JwtUtils.h"
+#include "env/Config.h"
+#include <cpprest/json.h>
+#include <iostream>
+
+namespace
+{
+    std::optional<std::filesystem::file_time_type> writeTime(const std::string &path)
+    {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(path, ec);
+        if (ec)
+            return std::nullopt;
+        return time;
+    }
+}
+
+Auth0KeyStore &Auth0KeyStore::getInstance()
+{
+    static Auth0KeyStore instance = []()
+    {
+        const Config &config = Config::get();
+        return Auth0KeyStore(config.auth0PublicKeyPath,
+                             config.auth0JwksPath,
+                             config.googleClientId,
+                             config.auth0Issuer,
+                             config.auth0KeysReload);
+    }();
+    return instance;
+}
+
+Auth0KeyStore::Auth0KeyStore(std::string pemPath, std::string jwksPath, std::string audience,
+                             std::string issuer, std::chrono::seconds reloadInterval)
+    : pemPath_(std::move(pemPath)), jwksPath_(std::move(jwksPath)), audience_(std::move(audience)),
+      issuer_(std::move(issuer)), reloadInterval_(reloadInterval)
+{
+    keys_.store(load(), std::memory_order_release);
+    nextCheck_.store((std::chrono::steady_clock::now() + reloadInterval_).time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+Auth0KeyStore::Verifier Auth0KeyStore::buildVerifier(const std::string &publicKeyPem) const
+{
+    return jwt::verify()
+        .allow_algorithm(jwt::algorithm::rs256(publicKeyPem, "", "", ""))
+        .with_issuer(issuer_)
+        .with_audience(audience_)
+        .leeway(60); // tolerancia opcional de 60 segundos
+}
+
+std::shared_ptr<const Auth0KeyStore::KeySet> Auth0KeyStore::load() const
+{
+    auto keys = std::make_shared<KeySet>();
+
+    if (auto time = writeTime(pemPath_))
+    {
+        try
+        {
+            keys->defaultVerifier = buildVerifier(Auth0JwtUtils::readPemFile(pemPath_));
+            keys->pemWriteTime = *time;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[Auth0KeyStore] Clave PEM inválida en " << pemPath_ << ": " << e.what() << std::endl;
+        }
+    }
+
+    if (!jwksPath_.empty())
+    {
+        if (auto time = writeTime(jwksPath_))
+        {
+            try
+            {
+                // Formato JWKS: {"keys": [{"kid": "...", "x5c": ["<certificado DER en base64>"]}]}
+                auto jwks = web::json::value::parse(utility::conversions::to_string_t(Auth0JwtUtils::readPemFile(jwksPath_)));
+                for (const auto &key : jwks.at(U("keys")).as_array())
+                {
+                    if (!key.has_field(U("kid")) || !key.has_field(U("x5c")))
+                        continue;
+                    auto kid = utility::conversions::to_utf8string(key.at(U("kid")).as_string());
+                    auto x5c = utility::conversions::to_utf8string(key.at(U("x5c")).as_array().at(0).as_string());
+                    keys->byKid.emplace(kid, buildVerifier(jwt::helper::convert_base64_der_to_pem(x5c)));
+                }
+                keys->jwksWriteTime = *time;
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[Auth0KeyStore] JWKS inválido en " << jwksPath_ << ": " << e.what() << std::endl;
+            }
+        }
+    }
+
+    std::cout << "[Auth0KeyStore] Claves cargadas: " << (keys->defaultVerifier ? 1 : 0) << " por defecto, "
+              << keys->byKid.size() << " por kid" << std::endl;
+    return keys;
+}
+
+bool Auth0KeyStore::filesChanged(const KeySet &keys) const
+{
+    auto pemTime = writeTime(pemPath_);
+    if (pemTime && *pemTime != keys.pemWriteTime)
+        return true;
+    if (!jwksPath_.empty())
+    {
+        auto jwksTime = writeTime(jwksPath_);
+        if (jwksTime && *jwksTime != keys.jwksWriteTime)
+            return true;
+    }
+    return false;
+}
+
+std::shared_ptr<const Auth0KeyStore::KeySet> Auth0KeyStore::current()
+{
+    auto keys = keys_.load(std::memory_order_acquire);
+    if (reloadInterval_.count() <= 0)
+        return keys;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now.time_since_epoch().count() < nextCheck_.load(std::memory_order_relaxed))
+        return keys;
+
+    // Solo un hilo mira los ficheros; el resto sigue verificando con la foto actual
+    std::unique_lock<std::mutex> lock(reloadMutex_, std::try_to_lock);
+    if (!lock.owns_lock() || now.time_since_epoch().count() < nextCheck_.load(std::memory_order_relaxed))
+        return keys;
+    nextCheck_.store((now + reloadInterval_).time_since_epoch().count(), std::memory_order_relaxed);
+
+    keys = keys_.load(std::memory_order_acquire);
+    if (filesChanged(*keys))
+    {
+        keys = load();
+        keys_.store(keys, std::memory_order_release);
+    }
+    return keys;
+}
+
+bool Auth0KeyStore::reload()
+{
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    auto keys = load();
+    keys_.store(keys, std::memory_order_release);
+    nextCheck_.store((std::chrono::steady_clock::now() + reloadInterval_).time_since_epoch().count(), std::memory_order_relaxed);
+    return keys->defaultVerifier.has_value() || !keys->byKid.empty();
+}
+
+DecodedUser Auth0KeyStore::verifyAndExtractUser(const std::string &token)
+{
+    return verifyAndExtractUser(jwt::decode(token));
+}
+
+DecodedUser Auth0KeyStore::verifyAndExtractUser(const Decoded &decoded)
+{
+    auto keys = current();
+
+    const Verifier *verifier = nullptr;
+    if (decoded.has_key_id())
+    {
+        auto it = keys->byKid.find(decoded.get_key_id());
+        if (it != keys->byKid.end())
+            verifier = &it->second;
+    }
+    if (!verifier && keys->defaultVerifier)
+        verifier = &keys->defaultVerifier.value();
+    if (!verifier)
+        throw std::runtime_error("No hay clave pública para verificar el token");
+
+    // Igual que antes: exp es obligatorio y la expiración no tiene tolerancia
+    if (!decoded.has_expires_at())
+        throw std::runtime_error("token without exp");
+    if (decoded.get_expires_at() < std::chrono::system_clock::now())
+        throw std::runtime_error("token expired");
+
+    verifier->verify(decoded);
+
+    DecodedUser user;
+    user.sub = decoded.get_payload_claim("sub").as_string();
+    if (decoded.has_payload_claim("email"))
+        user.email = decoded.get_payload_claim("email").as_string();
+    user.issuer = decoded.get_issuer();
+    user.exp = std::chrono::duration_cast<std::chrono::seconds>(decoded.get_expires_at().time_since_epoch()).count();
+    return user;
+}
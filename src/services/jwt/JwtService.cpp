@@ -1,13 +1,10 @@
 #include "services/jwt/JwtService.h"
 #include <jwt-cpp/jwt.h>
-#include "env/EnvLoader.h"
+#include "env/Config.h"
 
 std::string JwtService::generateToken(const std::string &user_id, const std::string &email)
 {
-    EnvLoader env(".env");
-    env.load();
-
-    std::string secret = env.get("JWT_SECRET", "");
+    const std::string &secret = Config::get().jwtSecret;
     if (secret.empty())
     {
         throw std::runtime_error("JWT_SECRET no está configurado");
@@ -46,11 +43,17 @@ std::optional<std::string> JwtService::decodeToken(const std::string &token)
 std::optional<DecodedUser> JwtService::verifyAndExtractUser(const std::string &token)
 {
     try {
-        EnvLoader env(".env");
-        env.load();
-        std::string secret = env.get("JWT_SECRET", "");
+        return verifyAndExtractUser(jwt::decode(token));
+    } catch (const std::exception& e) {
+        std::cerr << "Error verificando token local: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
 
-        auto decoded = jwt::decode(token);
+std::optional<DecodedUser> JwtService::verifyAndExtractUser(const decltype(jwt::decode(std::string())) &decoded)
+{
+    try {
+        const std::string &secret = Config::get().jwtSecret;
 
         // Verificar firma y claims
         auto verifier = jwt::verify()
@@ -60,13 +63,17 @@ std::optional<DecodedUser> JwtService::verifyAndExtractUser(const std::string &t
         verifier.verify(decoded);
 
         DecodedUser user;
-        if (decoded.has_payload_claim("user_id"))
+        if (decoded.has_payload_claim("user_id")) {
             user.sub = decoded.get_payload_claim("user_id").as_string();
+            user.id = std::stoi(user.sub);
+        }
 
         if (decoded.has_payload_claim("email"))
             user.email = decoded.get_payload_claim("email").as_string();
 
         user.issuer = decoded.get_issuer();
+        if (decoded.has_expires_at())
+            user.exp = std::chrono::duration_cast<std::chrono::seconds>(decoded.get_expires_at().time_since_epoch()).count();
 
         return user;
 
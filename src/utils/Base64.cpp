@@ -0,0 +1,359 @@
+#include "utils/Base64.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BASE64_X86 1
+#endif
+
+namespace
+{
+    constexpr char kStandardChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    constexpr char kUrlChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    constexpr uint8_t kInvalid = 0xFF;
+
+    constexpr std::array<uint8_t, 256> makeDecodeTable(const char *chars)
+    {
+        std::array<uint8_t, 256> table{};
+        for (auto &value : table)
+            value = kInvalid;
+        for (uint8_t i = 0; i < 64; ++i)
+            table[static_cast<uint8_t>(chars[i])] = i;
+        return table;
+    }
+
+    constexpr auto kStandardDecode = makeDecodeTable(kStandardChars);
+    constexpr auto kUrlDecode = makeDecodeTable(kUrlChars);
+
+    // Los bloques SIMD devuelven cuánta entrada consumieron; el resto lo
+    // termina la versión escalar. Decodificar puede escribir hasta 4 bytes
+    // más allá de la salida útil: el llamador deja ese margen.
+    using EncodeBlocks = size_t (*)(const uint8_t *in, size_t size, char *out, bool url);
+    using DecodeBlocks = size_t (*)(const char *in, size_t size, uint8_t *out, bool url, bool &ok);
+
+    size_t encodeScalar(const uint8_t *in, size_t size, char *out, bool url)
+    {
+        const char *chars = url ? kUrlChars : kStandardChars;
+        size_t i = 0;
+        for (; i + 3 <= size; i += 3)
+        {
+            uint32_t block = (uint32_t(in[i]) << 16) | (uint32_t(in[i + 1]) << 8) | in[i + 2];
+            *out++ = chars[(block >> 18) & 0x3F];
+            *out++ = chars[(block >> 12) & 0x3F];
+            *out++ = chars[(block >> 6) & 0x3F];
+            *out++ = chars[block & 0x3F];
+        }
+        return i;
+    }
+
+    size_t decodeScalar(const char *in, size_t size, uint8_t *out, bool url, bool &ok)
+    {
+        const auto &table = url ? kUrlDecode : kStandardDecode;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            uint8_t a = table[uint8_t(in[i])], b = table[uint8_t(in[i + 1])];
+            uint8_t c = table[uint8_t(in[i + 2])], d = table[uint8_t(in[i + 3])];
+            if ((a | b | c | d) & 0xC0) // kInvalid tiene los bits altos
+            {
+                ok = false;
+                return i;
+            }
+            uint32_t block = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+            *out++ = uint8_t(block >> 16);
+            *out++ = uint8_t(block >> 8);
+            *out++ = uint8_t(block);
+        }
+        return i;
+    }
+
+#ifdef BASE64_X86
+    // Codificación y decodificación de Wojciech Muła (pshufb + multiplicaciones)
+
+    __attribute__((target("sse4.1"))) inline __m128i encodeLanes(__m128i in, __m128i shiftLut)
+    {
+        // 12 bytes -> 16 índices de 6 bits, uno por byte
+        in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t1, t3);
+
+        // Índice -> carácter sumando el desplazamiento de su rango
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_sub_epi8(range, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+        return _mm_add_epi8(indices, _mm_shuffle_epi8(shiftLut, range));
+    }
+
+    __attribute__((target("sse4.1"))) inline __m128i encodeShiftLut(bool url)
+    {
+        return url ? _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -17, 32, 0, 0)
+                   : _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    }
+
+    __attribute__((target("sse4.1"))) size_t encodeSse41(const uint8_t *in, size_t size, char *out, bool url)
+    {
+        const __m128i shiftLut = encodeShiftLut(url);
+        size_t i = 0;
+        // Se leen 16 bytes para usar 12
+        for (; i + 16 <= size; i += 12, out += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), encodeLanes(block, shiftLut));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) size_t encodeAvx2(const uint8_t *in, size_t size, char *out, bool url)
+    {
+        const __m128i lut128 = encodeShiftLut(url);
+        const __m256i shiftLut = _mm256_broadcastsi128_si256(lut128);
+        const __m256i reshuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                   1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        size_t i = 0;
+        // Dos carriles de 12 bytes: el segundo empieza en +12 y lee hasta +28
+        for (; i + 28 <= size; i += 24, out += 32)
+        {
+            __m256i in256 = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 12)), 1);
+            in256 = _mm256_shuffle_epi8(in256, reshuffle);
+            __m256i t0 = _mm256_and_si256(in256, _mm256_set1_epi32(0x0fc0fc00));
+            __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+            __m256i t2 = _mm256_and_si256(in256, _mm256_set1_epi32(0x003f03f0));
+            __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+            __m256i indices = _mm256_or_si256(t1, t3);
+
+            __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+            __m256i chars = _mm256_add_epi8(indices, _mm256_shuffle_epi8(shiftLut, range));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), chars);
+        }
+        return i + encodeSse41(in + i, size - i, out, url);
+    }
+
+    // base64url se traduce al alfabeto estándar; '+' y '/' originales pasan a 0 (inválido)
+    __attribute__((target("sse4.1"))) inline __m128i urlToStandard(__m128i str)
+    {
+        __m128i foreign = _mm_or_si128(_mm_cmpeq_epi8(str, _mm_set1_epi8('+')), _mm_cmpeq_epi8(str, _mm_set1_epi8('/')));
+        str = _mm_blendv_epi8(str, _mm_set1_epi8('+'), _mm_cmpeq_epi8(str, _mm_set1_epi8('-')));
+        str = _mm_blendv_epi8(str, _mm_set1_epi8('/'), _mm_cmpeq_epi8(str, _mm_set1_epi8('_')));
+        return _mm_andnot_si128(foreign, str);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i urlToStandard(__m256i str)
+    {
+        __m256i foreign = _mm256_or_si256(_mm256_cmpeq_epi8(str, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(str, _mm256_set1_epi8('/')));
+        str = _mm256_blendv_epi8(str, _mm256_set1_epi8('+'), _mm256_cmpeq_epi8(str, _mm256_set1_epi8('-')));
+        str = _mm256_blendv_epi8(str, _mm256_set1_epi8('/'), _mm256_cmpeq_epi8(str, _mm256_set1_epi8('_')));
+        return _mm256_andnot_si256(foreign, str);
+    }
+
+    __attribute__((target("sse4.1"))) size_t decodeSse41(const char *in, size_t size, uint8_t *out, bool url, bool &ok)
+    {
+        const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16, out += 12)
+        {
+            __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+            if (url)
+                str = urlToStandard(str);
+
+            __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), nibble);
+            __m128i loNibbles = _mm_and_si128(str, nibble);
+            __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+            __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+            if (!_mm_testz_si128(lo, hi))
+            {
+                ok = false;
+                return i;
+            }
+
+            __m128i eq2F = _mm_cmpeq_epi8(str, _mm_set1_epi8('/'));
+            __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+            __m128i values = _mm_add_epi8(str, roll);
+
+            // 16 valores de 6 bits -> 12 bytes
+            __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+            __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+            packed = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), packed);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) size_t decodeAvx2(const char *in, size_t size, uint8_t *out, bool url, bool &ok)
+    {
+        const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                               0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                               0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                               0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                               0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                               0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                               0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32, out += 24)
+        {
+            __m256i str = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+            if (url)
+                str = urlToStandard(str);
+
+            __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), nibble);
+            __m256i loNibbles = _mm256_and_si256(str, nibble);
+            __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+            __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+            if (!_mm256_testz_si256(lo, hi))
+            {
+                ok = false;
+                return i;
+            }
+
+            __m256i eq2F = _mm256_cmpeq_epi8(str, _mm256_set1_epi8('/'));
+            __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+            __m256i values = _mm256_add_epi8(str, roll);
+
+            __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+            packed = _mm256_shuffle_epi8(packed, pack);
+            // Cada carril deja 12 bytes útiles al principio
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(packed));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm256_extracti128_si256(packed, 1));
+        }
+        return i + decodeSse41(in + i, size - i, out, url, ok);
+    }
+#endif
+
+    struct Implementation
+    {
+        const char *name;
+        EncodeBlocks encode;
+        DecodeBlocks decode;
+    };
+
+    const Implementation &selectedImplementation()
+    {
+        static const Implementation selected = []() -> Implementation
+        {
+#ifdef BASE64_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return {"avx2", encodeAvx2, decodeAvx2};
+            if (__builtin_cpu_supports("sse4.1"))
+                return {"sse4.1", encodeSse41, decodeSse41};
+#endif
+            return {"scalar", encodeScalar, decodeScalar};
+        }();
+        return selected;
+    }
+}
+
+std::string Base64::encode(std::string_view input, Alphabet alphabet)
+{
+    const bool url = alphabet == Alphabet::Url;
+    const char *chars = url ? kUrlChars : kStandardChars;
+    const auto *in = reinterpret_cast<const uint8_t *>(input.data());
+    const size_t size = input.size();
+
+    std::string out(4 * ((size + 2) / 3), '\0');
+    char *cursor = out.data();
+
+    size_t done = selectedImplementation().encode(in, size, cursor, url);
+    cursor += done / 3 * 4;
+    size_t scalar = encodeScalar(in + done, size - done, cursor, url);
+    cursor += scalar / 3 * 4;
+    done += scalar;
+
+    // Cola de 1 o 2 bytes
+    const size_t rest = size - done;
+    if (rest > 0)
+    {
+        uint32_t block = uint32_t(in[done]) << 16;
+        if (rest == 2)
+            block |= uint32_t(in[done + 1]) << 8;
+        *cursor++ = chars[(block >> 18) & 0x3F];
+        *cursor++ = chars[(block >> 12) & 0x3F];
+        if (rest == 2)
+            *cursor++ = chars[(block >> 6) & 0x3F];
+        else if (!url)
+            *cursor++ = '=';
+        if (!url)
+            *cursor++ = '=';
+    }
+
+    out.resize(static_cast<size_t>(cursor - out.data()));
+    return out;
+}
+
+std::optional<std::string> Base64::decode(std::string_view input, Alphabet alphabet)
+{
+    const bool url = alphabet == Alphabet::Url;
+    const auto &table = url ? kUrlDecode : kStandardDecode;
+
+    size_t size = input.size();
+    size_t padding = 0;
+    while (padding < 2 && size > 0 && input[size - 1] == '=')
+    {
+        --size;
+        ++padding;
+    }
+    // Estándar: longitud múltiplo de 4 con su relleno. Url: relleno opcional.
+    if (!url && (size + padding) % 4 != 0)
+        return std::nullopt;
+    if (url && padding > 0 && (size + padding) % 4 != 0)
+        return std::nullopt;
+    if (size % 4 == 1)
+        return std::nullopt;
+
+    const size_t outSize = size / 4 * 3 + (size % 4 == 0 ? 0 : size % 4 - 1);
+    std::string out(outSize + 4, '\0'); // margen para los stores SIMD de 16 bytes
+    auto *cursor = reinterpret_cast<uint8_t *>(out.data());
+
+    bool ok = true;
+    size_t done = selectedImplementation().decode(input.data(), size, cursor, url, ok);
+    if (!ok)
+        return std::nullopt;
+    cursor += done / 4 * 3;
+    size_t scalar = decodeScalar(input.data() + done, size - done, cursor, url, ok);
+    if (!ok)
+        return std::nullopt;
+    cursor += scalar / 4 * 3;
+    done += scalar;
+
+    // Cola de 2 o 3 caracteres
+    const size_t rest = size - done;
+    if (rest > 0)
+    {
+        uint8_t a = table[uint8_t(input[done])], b = table[uint8_t(input[done + 1])];
+        uint8_t c = rest == 3 ? table[uint8_t(input[done + 2])] : 0;
+        if (a == kInvalid || b == kInvalid || c == kInvalid)
+            return std::nullopt;
+        uint32_t block = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6);
+        *cursor++ = uint8_t(block >> 16);
+        if (rest == 3)
+            *cursor++ = uint8_t(block >> 8);
+    }
+
+    out.resize(outSize);
+    return out;
+}
+
+const char *Base64::implementation()
+{
+    return selectedImplementation().name;
+}
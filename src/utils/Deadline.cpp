@@ -0,0 +1,92 @@
+#include "utils/Deadline.h"
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Cola de plazos ordenada por vencimiento, atendida por un hilo propio
+    class DeadlineTimer
+    {
+    public:
+        static DeadlineTimer &getInstance()
+        {
+            static DeadlineTimer instance;
+            return instance;
+        }
+
+        void schedule(std::chrono::steady_clock::time_point at, pplx::cancellation_token_source source)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending_.push({at, std::move(source)});
+            }
+            changed_.notify_one();
+        }
+
+    private:
+        struct Entry
+        {
+            std::chrono::steady_clock::time_point at;
+            pplx::cancellation_token_source source;
+            bool operator>(const Entry &other) const { return at > other.at; }
+        };
+
+        DeadlineTimer()
+        {
+            std::thread([this]()
+                        { run(); })
+                .detach();
+        }
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                if (pending_.empty())
+                {
+                    changed_.wait(lock);
+                    continue;
+                }
+                auto next = pending_.top().at;
+                if (std::chrono::steady_clock::now() < next)
+                {
+                    changed_.wait_until(lock, next);
+                    continue;
+                }
+                auto source = pending_.top().source;
+                pending_.pop();
+                lock.unlock();
+                source.cancel(); // sin efecto si la petición ya terminó
+                lock.lock();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pending_;
+    };
+}
+
+Deadline::Deadline(std::chrono::milliseconds budget)
+    : at_(std::chrono::steady_clock::now() + budget)
+{
+    DeadlineTimer::getInstance().schedule(at_, source_);
+}
+
+bool Deadline::expired() const
+{
+    return std::chrono::steady_clock::now() >= at_ || token().is_canceled();
+}
+
+void Deadline::check() const
+{
+    if (expired())
+    {
+        source_.cancel();
+        throw pplx::task_canceled();
+    }
+}
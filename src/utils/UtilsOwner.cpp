@@ -1,39 +1,19 @@
 #include "utils/UtilsOwner.h"
+#include "utils/Base64.h"
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string_view>
 
 auto UtilsOwner::base64_encode(const std::string &input) -> std::string
 {
-    static const char encode_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::string encoded;
-    int val = 0, valb = -6;
-    for (unsigned char c : input)
-    {
-        val = (val << 8) + c;
-        valb += 8;
-        while (valb >= 0)
-        {
-            encoded.push_back(encode_table[(val >> valb) & 0x3F]);
-            valb -= 6;
-        }
-    }
-    if (valb > -6)
-        encoded.push_back(encode_table[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (encoded.size() % 4)
-        encoded.push_back('=');
-    return encoded;
+    return Base64::encode(input);
 }
 
-auto UtilsOwner::roundToTwoDecimal(double value) -> double
+auto UtilsOwner::base64_decode(const std::string &input) -> std::optional<std::string>
 {
-    return std::round(value * 100.0) / 100.0;
-}
-
-auto UtilsOwner::toString2Dec(double value) -> std::string
-{
-    std::ostringstream oss;
-    oss << std::fixed
-        << std::setprecision(2)
-        << value;
-    return oss.str();
+    return Base64::decode(input);
 }
 
 auto UtilsOwner::generateUuid() -> std::string
@@ -47,75 +27,133 @@ auto UtilsOwner::generateUuid() -> std::string
 
 
 // sha cart start
-static std::string serializeCart(int order_id, double total, const std::vector<OrderItem> &items)
+namespace
 {
-    // Copiamos y ordenamos para que el hash no dependa del orden original
-    std::vector<OrderItem> sorted = items;
-    std::sort(sorted.begin(), sorted.end(),
-              [](const OrderItem &a, const OrderItem &b)
-              {
-                  return a.product_id < b.product_id;
-              });
-
-    std::ostringstream oss;
-    // Serializar order_id y total (2 decimales)
-    oss << order_id << ':'
-        << std::fixed << std::setprecision(2) << total
-        << ':';
-
-    // Serializar cada ítem en formato "product_id:quantity:price;"
-    for (const auto &it : sorted)
+    // Un EVP_MD_CTX por hilo, reutilizado entre llamadas
+    EVP_MD_CTX *threadDigestContext()
     {
-        oss << it.product_id << ':'
-            << it.quantity << ':'
-            << std::fixed << std::setprecision(2) << it.price
-            << ';';
+        thread_local std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> context(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+        if (!context)
+            throw std::runtime_error("Failed to create EVP_MD_CTX");
+        return context.get();
     }
 
-    return oss.str();
-}
+    // Acumula texto en un buffer de pila y lo pasa al digest cuando se llena
+    class DigestWriter
+    {
+    public:
+        explicit DigestWriter(EVP_MD_CTX *context) : context_(context)
+        {
+            if (EVP_DigestInit_ex(context_, EVP_sha256(), nullptr) != 1)
+                throw std::runtime_error("Failed to initialize digest");
+        }
 
-// Función que calcula SHA256 y devuelve hex string
-static std::string sha256(const std::string &data)
-{
-    unsigned char hash[EVP_MAX_MD_SIZE];
-    unsigned int lengthOfHash = 0;
+        void put(std::string_view text)
+        {
+            if (size_ + text.size() > buffer_.size())
+                flush();
+            if (text.size() > buffer_.size())
+            {
+                update(text.data(), text.size());
+                return;
+            }
+            std::memcpy(buffer_.data() + size_, text.data(), text.size());
+            size_ += text.size();
+        }
 
-    EVP_MD_CTX* context = EVP_MD_CTX_new();
-    if (context == nullptr) {
-        throw std::runtime_error("Failed to create EVP_MD_CTX");
-    }
+        void put(char c) { put(std::string_view(&c, 1)); }
 
-    if (EVP_DigestInit_ex(context, EVP_sha256(), nullptr) != 1) {
-        EVP_MD_CTX_free(context);
-        throw std::runtime_error("Failed to initialize digest");
-    }
+        void put(long long value)
+        {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            put(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+        }
 
-    if (EVP_DigestUpdate(context, data.data(), data.size()) != 1) {
-        EVP_MD_CTX_free(context);
-        throw std::runtime_error("Failed to update digest");
-    }
+        std::string finishHex()
+        {
+            flush();
+            unsigned char hash[EVP_MAX_MD_SIZE];
+            unsigned int lengthOfHash = 0;
+            if (EVP_DigestFinal_ex(context_, hash, &lengthOfHash) != 1)
+                throw std::runtime_error("Failed to finalize digest");
+            return toHex(hash, lengthOfHash);
+        }
 
-    if (EVP_DigestFinal_ex(context, hash, &lengthOfHash) != 1) {
-        EVP_MD_CTX_free(context);
-        throw std::runtime_error("Failed to finalize digest");
-    }
+    private:
+        void flush()
+        {
+            if (size_ > 0)
+                update(buffer_.data(), size_);
+            size_ = 0;
+        }
+
+        void update(const char *data, size_t size)
+        {
+            if (EVP_DigestUpdate(context_, data, size) != 1)
+                throw std::runtime_error("Failed to update digest");
+        }
 
-    EVP_MD_CTX_free(context);
+        static std::string toHex(const unsigned char *data, unsigned int size)
+        {
+            static constexpr char kHex[] = "0123456789abcdef";
+            std::string hex(size * 2, '\0');
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                hex[2 * i] = kHex[data[i] >> 4];
+                hex[2 * i + 1] = kHex[data[i] & 0x0F];
+            }
+            return hex;
+        }
+
+        EVP_MD_CTX *context_;
+        std::array<char, 512> buffer_;
+        size_t size_ = 0;
+    };
+}
+
+// Función pública que obtiene el hash del carrito. Mismo texto que antes
+// ("order_id:total:" y luego "product_id:quantity:price;" por producto, en
+// orden de product_id), así que los hashes guardados siguen coincidiendo,
+// pero se escribe directo al digest sin copiar el carrito ni usar streams.
+std::string UtilsOwner::hashCart(int order_id, const Money &total, const std::vector<OrderItem> &items)
+{
+    // Se ordenan índices, no copias de las líneas; el vector se reutiliza por hilo
+    thread_local std::vector<uint32_t> order;
+    order.resize(items.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&items](uint32_t a, uint32_t b)
+              {
+                  return items[a].product_id < items[b].product_id;
+              });
 
-    std::ostringstream oss;
-    for (unsigned int i = 0; i < lengthOfHash; ++i)
+    DigestWriter writer(threadDigestContext());
+    writer.put(static_cast<long long>(order_id));
+    writer.put(':');
+    writer.put(total.format().view());
+    writer.put(':');
+
+    for (uint32_t index : order)
     {
-        oss << std::hex << std::setw(2) << std::setfill('0') << (int)hash[i];
+        const OrderItem &it = items[index];
+        writer.put(static_cast<long long>(it.product_id));
+        writer.put(':');
+        writer.put(static_cast<long long>(it.quantity));
+        writer.put(':');
+        writer.put(it.price.format().view());
+        writer.put(';');
     }
-    return oss.str();
+
+    return writer.finishHex();
 }
 
-// Función pública que obtiene el hash del carrito
-std::string UtilsOwner::hashCart(int order_id, double total, const std::vector<OrderItem> &items)
+std::string UtilsOwner::sha256Hex(const std::string &data)
 {
-    std::string serialized = serializeCart(order_id, total, items);
-    return sha256(serialized);
+    DigestWriter writer(threadDigestContext());
+    writer.put(std::string_view(data));
+    return writer.finishHex();
 }
 
-//sha cart end
\ No newline at end of file
+//sha cart end